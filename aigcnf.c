@@ -0,0 +1,235 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "aigcnf.h"
+
+/* A hash table of all Tseitin-encoded and gates
+ * Conventions (the same as for the and gates in task2aig):
+ * (1) literals are positive or negative integers depending on whether they
+ * are negated
+ * (2) the key is composed of the left operand (literal) and the right operand
+ * with the left operand being the "smaller" variable (not literal)
+ * (3) variables are indexed from 2 (so 1 is "True" and -1 is "False")
+ * An entry with opLeft == 0 is empty.
+ */
+typedef struct {
+    int opLeft;
+    int opRight;
+    int var;
+} CnfGate;
+
+typedef struct {
+    CnfGate* gates;
+    unsigned capacity;  // always a power of 2
+    unsigned noGates;
+    int nextVar;
+    // clauses are stored one after the other, each terminated by 0
+    int* lits;
+    size_t noLits;
+    size_t capLits;
+    unsigned noClauses;
+} CnfTable;
+
+static inline unsigned hashGate(int opLeft, int opRight) {
+    return ((unsigned) opLeft * 2654435761u) ^ ((unsigned) opRight * 40503u);
+}
+
+static void pushLit(CnfTable* table, int lit) {
+    if (table->noLits == table->capLits) {
+        table->capLits = table->capLits ? 2 * table->capLits : 1024;
+        table->lits = realloc(table->lits, table->capLits * sizeof(int));
+    }
+    table->lits[table->noLits++] = lit;
+    if (lit == 0)
+        table->noClauses++;
+}
+
+static void growTable(CnfTable* table) {
+    CnfGate* old = table->gates;
+    unsigned oldCapacity = table->capacity;
+    table->capacity = oldCapacity ? 2 * oldCapacity : 1024;
+    table->gates = calloc(table->capacity, sizeof(CnfGate));
+    for (unsigned i = 0; i < oldCapacity; i++) {
+        if (old[i].opLeft == 0)
+            continue;
+        unsigned h = hashGate(old[i].opLeft, old[i].opRight);
+        h &= table->capacity - 1;
+        while (table->gates[h].opLeft != 0)
+            h = (h + 1) & (table->capacity - 1);
+        table->gates[h] = old[i];
+    }
+    free(old);
+}
+
+static int and(CnfTable* table, int op1, int op2) {
+    assert(op1 != 0 && op2 != 0);
+    // constant propagation and trivial cases first
+    if (op1 == -1 || op2 == -1 || op1 == -op2)
+        return -1;
+    if (op1 == 1 || op1 == op2)
+        return op2;
+    if (op2 == 1)
+        return op1;
+    if (abs(op1) > abs(op2)) {
+        int temp = op1;
+        op1 = op2;
+        op2 = temp;
+    }
+    // then we look for a structurally equal gate
+    if (2 * (table->noGates + 1) > table->capacity)
+        growTable(table);
+    unsigned h = hashGate(op1, op2) & (table->capacity - 1);
+    while (table->gates[h].opLeft != 0) {
+        CnfGate* g = table->gates + h;
+        if (g->opLeft == op1 && g->opRight == op2)
+            return g->var;
+        h = (h + 1) & (table->capacity - 1);
+    }
+    // none found, we need a fresh one and its Tseitin clauses
+    int var = table->nextVar++;
+    table->gates[h].opLeft = op1;
+    table->gates[h].opRight = op2;
+    table->gates[h].var = var;
+    table->noGates++;
+    pushLit(table, -var);
+    pushLit(table, op1);
+    pushLit(table, 0);
+    pushLit(table, -var);
+    pushLit(table, op2);
+    pushLit(table, 0);
+    pushLit(table, var);
+    pushLit(table, -op1);
+    pushLit(table, -op2);
+    pushLit(table, 0);
+    return var;
+}
+
+static inline int lit2cnf(int* val, unsigned lit) {
+    int ret = val[aiger_lit2var(lit)];
+    return aiger_sign(lit) ? -ret : ret;
+}
+
+static void printMapEntry(FILE* file, const char* kind, unsigned frame,
+                          int lit, const char* name, unsigned idx) {
+    if (name != NULL)
+        fprintf(file, "c %s %u %d %s\n", kind, frame, lit, name);
+    else
+        fprintf(file, "c %s %u %d %c%u\n", kind, frame, lit, kind[0], idx);
+}
+
+int writeUnrolledCnf(aiger* aig, unsigned bound, FILE* file) {
+    // reencoding gives us the and gates in topological order
+    aiger_reencode(aig);
+
+    CnfTable table;
+    table.gates = NULL;
+    table.capacity = 0;
+    table.noGates = 0;
+    table.nextVar = 2;
+    table.lits = NULL;
+    table.noLits = 0;
+    table.capLits = 0;
+    table.noClauses = 0;
+    // variable 1 is the constant "True"
+    pushLit(&table, 1);
+    pushLit(&table, 0);
+
+    int* val = malloc((aig->maxvar + 1) * sizeof(int));
+    int* nextVal = malloc((aig->num_latches + 1) * sizeof(int));
+    unsigned noTargets = 0;
+    int* targets = malloc(((aig->num_outputs + aig->num_bad) * (bound + 1) + 1)
+                          * sizeof(int));
+    val[0] = -1;
+
+    fprintf(file, "c unrolled for %u steps\n", bound);
+    fprintf(file, "c map: (input|latch) FRAME CNFLIT NAME\n");
+    for (unsigned frame = 0; frame <= bound; frame++) {
+        for (unsigned i = 0; i < aig->num_inputs; i++) {
+            aiger_symbol* sym = aig->inputs + i;
+            val[aiger_lit2var(sym->lit)] = table.nextVar++;
+            printMapEntry(file, "input", frame,
+                          val[aiger_lit2var(sym->lit)], sym->name, i);
+        }
+        for (unsigned i = 0; i < aig->num_latches; i++) {
+            aiger_symbol* sym = aig->latches + i;
+            int v;
+            if (frame > 0)
+                v = nextVal[i];
+            else if (sym->reset == aiger_false)
+                v = -1;
+            else if (sym->reset == aiger_true)
+                v = 1;
+            else  // uninitialized, so any value is possible
+                v = table.nextVar++;
+            val[aiger_lit2var(sym->lit)] = v;
+            printMapEntry(file, "latch", frame, v, sym->name, i);
+        }
+        for (unsigned i = 0; i < aig->num_ands; i++) {
+            aiger_and* gate = aig->ands + i;
+            val[aiger_lit2var(gate->lhs)] = and(&table,
+                                                lit2cnf(val, gate->rhs0),
+                                                lit2cnf(val, gate->rhs1));
+        }
+        for (unsigned i = 0; i < aig->num_outputs; i++)
+            targets[noTargets++] = lit2cnf(val, aig->outputs[i].lit);
+        for (unsigned i = 0; i < aig->num_bad; i++)
+            targets[noTargets++] = lit2cnf(val, aig->bad[i].lit);
+        for (unsigned i = 0; i < aig->num_latches; i++)
+            nextVal[i] = lit2cnf(val, aig->latches[i].next);
+    }
+
+    // the property: some target holds in some frame
+    bool someTarget = false;
+    for (unsigned i = 0; i < noTargets; i++) {
+        if (targets[i] == -1)
+            continue;
+        pushLit(&table, targets[i]);
+        someTarget = true;
+    }
+    if (!someTarget)
+        pushLit(&table, -1);
+    pushLit(&table, 0);
+
+#ifndef NDEBUG
+    fprintf(stderr, "Unrolled into %d variables and %u clauses\n",
+            table.nextVar - 1, table.noClauses);
+#endif
+    fprintf(file, "p cnf %d %u\n", table.nextVar - 1, table.noClauses);
+    for (size_t i = 0; i < table.noLits; i++) {
+        if (table.lits[i] == 0)
+            fputs("0\n", file);
+        else
+            fprintf(file, "%d ", table.lits[i]);
+    }
+
+    // Free dynamic memory
+    free(targets);
+    free(nextVal);
+    free(val);
+    free(table.lits);
+    free(table.gates);
+    return !ferror(file);
+}
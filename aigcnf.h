@@ -0,0 +1,44 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+#ifndef AIGCNF_H
+#define AIGCNF_H
+
+#include <stdio.h>
+
+#include "aiger/aiger.h"
+
+/* Unroll the AIG for bound steps starting from the reset state of its
+ * latches and write a DIMACS CNF which is satisfiable if and only if some
+ * output (or bad-state literal) is true in one of the time frames
+ * 0, 1, ..., bound. All inputs are free in every frame, so a model is a
+ * scheduler-independent run reaching the property.
+ * The and gates are Tseitin-encoded with constant propagation and
+ * structural hashing, so identical gates (in particular across frames)
+ * share a single CNF variable. Variable 1 is the constant "True".
+ * The header comments map the value of each input and latch in each frame
+ * to a (possibly negated) CNF literal.
+ * NOTE: this reencodes the AIG, so literals of aig are invalidated
+ * Returns zero on failure.
+ */
+int writeUnrolledCnf(aiger* aig, unsigned bound, FILE* file);
+
+#endif
@@ -27,7 +27,25 @@ IN THE SOFTWARE.
 #include <stdlib.h>
 #include <assert.h>
 #include <ctype.h>
+#include <stdint.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef AIGER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef AIGER_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /*------------------------------------------------------------------------*/
 
@@ -49,8 +67,18 @@ aiger_version (void)
 
 /*------------------------------------------------------------------------*/
 
+/* Files with a '.gz' or '.zst' suffix are compressed in process if the
+ * library is compiled with 'AIGER_HAVE_ZLIB' respectively
+ * 'AIGER_HAVE_ZSTD' and otherwise piped through these programs.
+ */
 #define GZIP "gzip -c > %s 2>/dev/null"
 #define GUNZIP "gunzip -c %s 2>/dev/null"
+#define ZSTD "zstd -q -c > %s 2>/dev/null"
+#define UNZSTD "zstd -q -d -c %s 2>/dev/null"
+
+/* Size of the blocks in which files are read and written.
+ */
+#define AIGER_BLOCK_SIZE (1 << 16)
 
 #define NEWN(p,n) \
   do { \
@@ -119,6 +147,7 @@ aiger_version (void)
 typedef struct aiger_private aiger_private;
 typedef struct aiger_buffer aiger_buffer;
 typedef struct aiger_reader aiger_reader;
+typedef struct aiger_writer aiger_writer;
 typedef struct aiger_type aiger_type;
 
 struct aiger_type
@@ -145,6 +174,12 @@ struct aiger_private
   unsigned char * coi;
   unsigned size_coi;
 
+  /* Cached result of 'aiger_is_reencoded'.  The 'aiger_add_*' functions
+   * keep it set as long as inputs, latches and ANDs arrive in the order
+   * and with the indices of the binary format.
+   */
+  int reencoded;
+
   unsigned size_inputs;
   unsigned size_latches;
   unsigned size_outputs;
@@ -161,6 +196,22 @@ struct aiger_private
   aiger_malloc malloc_callback;
   aiger_free free_callback;
 
+  aiger_arena *arena;		/* owned, see 'aiger_init_arena' */
+
+  aiger_read_mode read_mode;
+
+  /* A file mapped by 'aiger_open_and_map' and, as long as it is not
+   * decoded, the binary AND section in it with the position of its first
+   * character for error messages.
+   */
+  void *map;
+  size_t size_map;
+  const unsigned char *lazy_ands;
+  size_t size_lazy_ands;
+  unsigned num_lazy_ands;
+  unsigned lazy_lineno;
+  unsigned lazy_charno;
+
   char *error;
 };
 
@@ -171,11 +222,65 @@ struct aiger_buffer
   char *end;
 };
 
+/* Characters are written to 'block' and flushed to 'file' or, if that is
+ * zero, through 'put' when the block is full and at the end.  A compressing
+ * writer flushes to 'gz' or through 'zstd' (and 'zblock') to 'file'.
+ */
+struct aiger_writer
+{
+  void *state;
+  aiger_put put;
+  FILE *file;
+
+#ifdef AIGER_HAVE_ZLIB
+  gzFile gz;
+#endif
+#ifdef AIGER_HAVE_ZSTD
+  ZSTD_CStream *zstd;
+  char *zblock;
+#endif
+
+  char *block;
+  char *cursor;
+  char *end;
+
+  int error;
+};
+
 struct aiger_reader
 {
   void *state;
   aiger_get get;
 
+  /* If 'buffered' is set, characters are taken from the block between
+   * 'cursor' and 'end' instead of through 'get', and the block is refilled
+   * from 'file' (if any) with 'fread' (see 'aiger_refill').  Compressed
+   * files are decoded from 'gz' or through 'zstd' from 'file', in which
+   * case 'zin' holds the compressed bytes and 'zleft' is non zero while
+   * a frame is incomplete.  If decoding fails, the reason is kept in
+   * 'zerror' and the file looks as if it ended there.
+   */
+  int buffered;
+  FILE *file;
+#ifdef AIGER_HAVE_ZLIB
+  gzFile gz;
+#endif
+#ifdef AIGER_HAVE_ZSTD
+  ZSTD_DStream *zstd;
+  ZSTD_inBuffer zin;
+  size_t zleft;
+#endif
+#if defined(AIGER_HAVE_ZLIB) || defined(AIGER_HAVE_ZSTD)
+  const char *zerror;
+#endif
+  unsigned char *block;
+  const unsigned char *cursor;
+  const unsigned char *end;
+
+  /* Only locate a binary AND section, see 'aiger_open_and_map'.
+   */
+  int lazy;
+
   int ch;
 
   unsigned lineno;
@@ -216,6 +321,7 @@ aiger_init_mem (void *memory_mgr,
   private->memory_mgr = memory_mgr;
   private->malloc_callback = external_malloc;
   private->free_callback = external_free;
+  private->reencoded = 1;
   public = &private->public;
   PUSH (public->comments, private->num_comments, private->size_comments, 0);
 
@@ -240,6 +346,126 @@ aiger_init (void)
   return aiger_init_mem (0, aiger_default_malloc, aiger_default_free);
 }
 
+/* Blocks of an arena are kept in a doubly linked list, so that a block of
+ * a large allocation can be unlinked when it is freed.  The header is
+ * padded to keep the memory after it aligned.
+ */
+typedef union aiger_block aiger_block;
+
+union aiger_block
+{
+  struct
+  {
+    aiger_block *prev;
+    aiger_block *next;
+  } link;
+  long double align_ld;
+  void *align_ptr;
+  uint64_t align_u64;
+};
+
+struct aiger_arena
+{
+  aiger_block *blocks;
+  char *cursor;
+  char *end;
+};
+
+#define AIGER_ARENA_BLOCK_SIZE (1 << 16)
+#define AIGER_ARENA_LARGE (AIGER_ARENA_BLOCK_SIZE / 4)
+#define AIGER_ARENA_ALIGN sizeof (aiger_block)
+
+aiger_arena *
+aiger_new_arena (void)
+{
+  aiger_arena *res = malloc (sizeof (*res));
+  res->blocks = 0;
+  res->cursor = res->end = 0;
+  return res;
+}
+
+void
+aiger_delete_arena (aiger_arena * arena)
+{
+  aiger_block *block, *next;
+
+  for (block = arena->blocks; block; block = next)
+    {
+      next = block->link.next;
+      free (block);
+    }
+
+  free (arena);
+}
+
+static void *
+aiger_arena_block (aiger_arena * arena, size_t bytes)
+{
+  aiger_block *block = malloc (sizeof (*block) + bytes);
+
+  block->link.prev = 0;
+  block->link.next = arena->blocks;
+  if (arena->blocks)
+    arena->blocks->link.prev = block;
+  arena->blocks = block;
+
+  return block + 1;
+}
+
+void *
+aiger_arena_malloc (void *state, size_t bytes)
+{
+  aiger_arena *arena = state;
+  void *res;
+
+  if (bytes > AIGER_ARENA_LARGE)
+    return aiger_arena_block (arena, bytes);
+
+  bytes = (bytes + AIGER_ARENA_ALIGN - 1) / AIGER_ARENA_ALIGN;
+  bytes *= AIGER_ARENA_ALIGN;
+  if ((size_t) (arena->end - arena->cursor) < bytes)
+    {
+      arena->cursor = aiger_arena_block (arena, AIGER_ARENA_BLOCK_SIZE);
+      arena->end = arena->cursor + AIGER_ARENA_BLOCK_SIZE;
+    }
+
+  res = arena->cursor;
+  arena->cursor += bytes;
+
+  return res;
+}
+
+void
+aiger_arena_free (void *state, void *ptr, size_t bytes)
+{
+  aiger_arena *arena = state;
+  aiger_block *block;
+
+  if (!ptr || bytes <= AIGER_ARENA_LARGE)
+    return;
+
+  block = ((aiger_block *) ptr) - 1;
+  if (block->link.prev)
+    block->link.prev->link.next = block->link.next;
+  else
+    arena->blocks = block->link.next;
+  if (block->link.next)
+    block->link.next->link.prev = block->link.prev;
+
+  free (block);
+}
+
+aiger *
+aiger_init_arena (void)
+{
+  aiger_arena *arena = aiger_new_arena ();
+  aiger *public = aiger_init_mem (arena,
+				  aiger_arena_malloc, aiger_arena_free);
+  IMPORT_private_FROM (public);
+  private->arena = arena;
+  return public;
+}
+
 static void
 aiger_delete_str (aiger_private * private, char *str)
 {
@@ -313,6 +539,17 @@ aiger_reset (aiger * public)
 
   IMPORT_private_FROM (public);
 
+  if (private->map)
+    munmap (private->map, private->size_map);
+
+  /* Everything, including 'private', is in the arena.
+   */
+  if (private->arena)
+    {
+      aiger_delete_arena (private->arena);
+      return;
+    }
+
   aiger_delete_symbols (private, public->inputs, private->size_inputs);
   aiger_delete_symbols (private, public->latches, private->size_latches);
   aiger_delete_symbols (private, public->outputs, private->size_outputs);
@@ -335,6 +572,21 @@ aiger_reset (aiger * public)
   DELETE (private);
 }
 
+/* The size an array of 'size' elements grows to, if it has to hold
+ * 'needed' elements, which is at least double the old size as in 'ENLARGE'.
+ */
+static unsigned
+aiger_grown_size (unsigned size, unsigned needed)
+{
+  if (needed <= size)
+    return size;
+
+  if (needed < 2 * size)
+    return 2 * size;
+
+  return needed;
+}
+
 static aiger_type *
 aiger_import_literal (aiger_private * private, unsigned lit)
 {
@@ -344,8 +596,11 @@ aiger_import_literal (aiger_private * private, unsigned lit)
   if (var > public->maxvar)
     public->maxvar = var;
 
-  while (var >= private->size_types)
-    ENLARGE (private->types, private->size_types);
+  /* Grow in one step, even if 'var' is far beyond the current size.
+   */
+  if (var >= private->size_types)
+    FIT (private->types, private->size_types,
+	 aiger_grown_size (private->size_types, var + 1));
 
   return private->types + var;
 }
@@ -371,6 +626,10 @@ aiger_add_input (aiger * public, unsigned lit, const char *name)
   type->input = 1;
   type->idx = public->num_inputs;
 
+  if (public->num_latches || public->num_ands ||
+      lit != aiger_var2lit (public->num_inputs + 1))
+    private->reencoded = 0;
+
   CLR (symbol);
   symbol.lit = lit;
   symbol.name = aiger_copy_str (private, name);
@@ -402,6 +661,10 @@ aiger_add_latch (aiger * public,
   type->latch = 1;
   type->idx = public->num_latches;
 
+  if (public->num_ands ||
+      lit != aiger_var2lit (public->num_inputs + public->num_latches + 1))
+    private->reencoded = 0;
+
   aiger_import_literal (private, next);
 
   CLR (symbol);
@@ -506,7 +769,8 @@ aiger_add_and (aiger * public, unsigned lhs, unsigned rhs0, unsigned rhs1)
   aiger_type *type;
   aiger_and *and;
 
-  assert (!aiger_error (public));
+  if (aiger_decode_ands (public))
+    return;
 
   assert (lhs > 1);
   assert (!aiger_sign (lhs));
@@ -520,6 +784,11 @@ aiger_add_and (aiger * public, unsigned lhs, unsigned rhs0, unsigned rhs1)
   type->and = 1;
   type->idx = public->num_ands;
 
+  if (lhs != aiger_var2lit (public->num_inputs + public->num_latches +
+			    public->num_ands + 1) ||
+      lhs < rhs0 || rhs0 < rhs1)
+    private->reencoded = 0;
+
   aiger_import_literal (private, rhs0);
   aiger_import_literal (private, rhs1);
 
@@ -535,6 +804,117 @@ aiger_add_and (aiger * public, unsigned lhs, unsigned rhs0, unsigned rhs1)
   public->num_ands++;
 }
 
+void
+aiger_reserve (aiger * public,
+	       unsigned inputs, unsigned latches, unsigned ands,
+	       unsigned maxvar)
+{
+  IMPORT_private_FROM (public);
+
+  assert (!aiger_error (public));
+
+  FIT (private->types, private->size_types, maxvar + 1);
+  FIT (public->inputs, private->size_inputs, inputs);
+  FIT (public->latches, private->size_latches, latches);
+  FIT (public->ands, private->size_ands, ands);
+}
+
+static unsigned
+aiger_max_var_of_symbols (unsigned size, const aiger_symbol * symbols,
+			  int latches)
+{
+  unsigned i, res, tmp;
+
+  res = 0;
+  for (i = 0; i < size; i++)
+    {
+      tmp = aiger_lit2var (symbols[i].lit);
+      if (tmp > res)
+	res = tmp;
+
+      if (!latches)
+	continue;
+
+      tmp = aiger_lit2var (symbols[i].next);
+      if (tmp > res)
+	res = tmp;
+    }
+
+  return res;
+}
+
+void
+aiger_add_inputs (aiger * public, unsigned size, const aiger_symbol * inputs)
+{
+  IMPORT_private_FROM (public);
+  unsigned i, maxvar;
+
+  maxvar = aiger_max_var_of_symbols (size, inputs, 0);
+
+  aiger_reserve (public,
+		 aiger_grown_size (private->size_inputs,
+				   public->num_inputs + size), 0, 0,
+		 aiger_grown_size (private->size_types, maxvar + 1) - 1);
+
+  for (i = 0; i < size; i++)
+    aiger_add_input (public, inputs[i].lit, inputs[i].name);
+}
+
+void
+aiger_add_latches (aiger * public,
+		   unsigned size, const aiger_symbol * latches)
+{
+  IMPORT_private_FROM (public);
+  unsigned i, maxvar;
+
+  maxvar = aiger_max_var_of_symbols (size, latches, 1);
+
+  aiger_reserve (public,
+		 0, aiger_grown_size (private->size_latches,
+				      public->num_latches + size), 0,
+		 aiger_grown_size (private->size_types, maxvar + 1) - 1);
+
+  for (i = 0; i < size; i++)
+    {
+      aiger_add_latch (public, latches[i].lit, latches[i].next,
+		       latches[i].name);
+      if (latches[i].reset)
+	aiger_add_reset (public, latches[i].lit, latches[i].reset);
+    }
+}
+
+void
+aiger_add_ands (aiger * public, unsigned size, const aiger_and * ands)
+{
+  IMPORT_private_FROM (public);
+  unsigned i, maxvar, tmp;
+
+  maxvar = 0;
+  for (i = 0; i < size; i++)
+    {
+      tmp = aiger_lit2var (ands[i].lhs);
+      if (tmp > maxvar)
+	maxvar = tmp;
+      tmp = aiger_lit2var (ands[i].rhs0);
+      if (tmp > maxvar)
+	maxvar = tmp;
+      tmp = aiger_lit2var (ands[i].rhs1);
+      if (tmp > maxvar)
+	maxvar = tmp;
+    }
+
+  if (aiger_decode_ands (public))
+    return;
+
+  aiger_reserve (public,
+		 0, 0, aiger_grown_size (private->size_ands,
+					 public->num_ands + size),
+		 aiger_grown_size (private->size_types, maxvar + 1) - 1);
+
+  for (i = 0; i < size; i++)
+    aiger_add_and (public, ands[i].lhs, ands[i].rhs0, ands[i].rhs1);
+}
+
 void
 aiger_add_comment (aiger * public, const char *comment)
 {
@@ -889,6 +1269,9 @@ aiger_check (aiger * public)
 {
   IMPORT_private_FROM (public);
 
+  if (aiger_decode_ands (public))
+    return private->error;
+
   assert (!aiger_error (public));
 
   aiger_check_next_defined (private);
@@ -904,125 +1287,277 @@ aiger_check (aiger * public)
 }
 
 static int
-aiger_default_get (FILE * file)
+aiger_string_put (char ch, aiger_buffer * buffer)
 {
-  return getc (file);
+  if (buffer->cursor == buffer->end)
+    return EOF;
+  *buffer->cursor++ = ch;
+  return ch;
 }
 
+#ifdef AIGER_HAVE_ZSTD
+/* Compress 'bytes' characters of the block and write the result to the
+ * file.  With 'ZSTD_e_end' the frame is also finished.  Returns zero on
+ * failure.
+ */
 static int
-aiger_default_put (char ch, FILE * file)
+aiger_zstd_write (aiger_writer * writer, size_t bytes, ZSTD_EndDirective end)
 {
-  return putc ((unsigned char) ch, file);
+  ZSTD_inBuffer in;
+  ZSTD_outBuffer out;
+  size_t left;
+
+  in.src = writer->block;
+  in.size = bytes;
+  in.pos = 0;
+
+  do
+    {
+      out.dst = writer->zblock;
+      out.size = AIGER_BLOCK_SIZE;
+      out.pos = 0;
+
+      left = ZSTD_compressStream2 (writer->zstd, &out, &in, end);
+      if (ZSTD_isError (left))
+	return 0;
+
+      if (fwrite (writer->zblock, 1, out.pos, writer->file) != out.pos)
+	return 0;
+    }
+  while (end == ZSTD_e_end ? left > 0 : in.pos < in.size);
+
+  return 1;
 }
+#endif
 
+/* Write the buffered characters, with 'fwrite' if the writer has a FILE
+ * and otherwise one by one through 'put'.  Returns 'EOF' on failure, which
+ * is sticky.
+ */
 static int
-aiger_string_put (char ch, aiger_buffer * buffer)
+aiger_flush (aiger_writer * writer)
 {
-  if (buffer->cursor == buffer->end)
+  size_t bytes;
+  char *p;
+
+  bytes = writer->cursor - writer->block;
+  writer->cursor = writer->block;
+
+  if (writer->error)
     return EOF;
-  *buffer->cursor++ = ch;
-  return ch;
+
+#ifdef AIGER_HAVE_ZLIB
+  if (writer->gz)
+    {
+      if (bytes && gzwrite (writer->gz, writer->block, bytes) != (int) bytes)
+	writer->error = 1;
+    }
+  else
+#endif
+#ifdef AIGER_HAVE_ZSTD
+  if (writer->zstd)
+    {
+      if (!aiger_zstd_write (writer, bytes, ZSTD_e_continue))
+	writer->error = 1;
+    }
+  else
+#endif
+  if (writer->file)
+    {
+      if (fwrite (writer->block, 1, bytes, writer->file) != bytes)
+	writer->error = 1;
+    }
+  else
+    {
+      for (p = writer->block; p < writer->block + bytes; p++)
+	if (writer->put (*p, writer->state) == EOF)
+	  {
+	    writer->error = 1;
+	    break;
+	  }
+    }
+
+  return writer->error ? EOF : 0;
 }
 
 static int
-aiger_put_s (void *state, aiger_put put, const char *str)
+aiger_put_ch (aiger_writer * writer, char ch)
 {
-  const char *p;
-  char ch;
+  if (writer->cursor == writer->end && aiger_flush (writer) == EOF)
+    return EOF;
+
+  *writer->cursor++ = ch;
+
+  return (unsigned char) ch;
+}
+
+static int
+aiger_put_bytes (aiger_writer * writer, const char *bytes, size_t size)
+{
+  size_t i;
 
-  for (p = str; (ch = *p); p++)
-    if (put (ch, state) == EOF)
+  if (writer->end - writer->cursor >= (long) size)
+    {
+      memcpy (writer->cursor, bytes, size);
+      writer->cursor += size;
+      return 0;
+    }
+
+  for (i = 0; i < size; i++)
+    if (aiger_put_ch (writer, bytes[i]) == EOF)
       return EOF;
 
-  return p - str;		/* 'fputs' semantics, >= 0 is OK */
+  return 0;
+}
+
+static int
+aiger_put_s (aiger_writer * writer, const char *str)
+{
+  size_t len = strlen (str);
+
+  if (aiger_put_bytes (writer, str, len) == EOF)
+    return EOF;
+
+  return len;			/* 'fputs' semantics, >= 0 is OK */
 }
 
 static int
-aiger_put_u (void *state, aiger_put put, unsigned u)
+aiger_put_u (aiger_writer * writer, unsigned u)
 {
-  char buffer[sizeof (u) * 4];
-  sprintf (buffer, "%u", u);
-  return aiger_put_s (state, put, buffer);
+  char digits[sizeof (u) * 3], *p;
+
+  p = digits + sizeof (digits);
+  do
+    *--p = '0' + u % 10;
+  while ((u /= 10));
+
+  return aiger_put_bytes (writer, p, digits + sizeof (digits) - p);
 }
 
 static int
-aiger_write_delta (void *state, aiger_put put, unsigned delta)
+aiger_write_delta (aiger_writer * writer, unsigned delta)
 {
   unsigned char ch;
   unsigned tmp = delta;
 
+  /* a delta takes at most 5 bytes, which usually fit into the block */
+  if (writer->end - writer->cursor >= 5)
+    {
+      while (tmp & ~0x7f)
+	{
+	  *writer->cursor++ = (tmp & 0x7f) | 0x80;
+	  tmp >>= 7;
+	}
+      *writer->cursor++ = tmp;
+      return 1;
+    }
+
   while (tmp & ~0x7f)
     {
       ch = tmp & 0x7f;
       ch |= 0x80;
 
-      if (put (ch, state) == EOF)
+      if (aiger_put_ch (writer, ch) == EOF)
 	return 0;
 
       tmp >>= 7;
     }
 
   ch = tmp;
-  return put (ch, state) != EOF;
+  return aiger_put_ch (writer, ch) != EOF;
+}
+
+/* Set up a writer for 'file' or, if that is zero, for 'put'.
+ */
+static void
+aiger_init_writer (aiger_private * private, aiger_writer * writer,
+		   FILE * file, void *state, aiger_put put)
+{
+  CLR (*writer);
+  writer->file = file;
+  writer->state = state;
+  writer->put = put;
+  NEWN (writer->block, AIGER_BLOCK_SIZE);
+  writer->cursor = writer->block;
+  writer->end = writer->block + AIGER_BLOCK_SIZE;
+}
+
+/* Flush and release the writer, the result is zero on failure.
+ */
+static int
+aiger_release_writer (aiger_private * private, aiger_writer * writer, int res)
+{
+  if (aiger_flush (writer) == EOF)
+    res = 0;
+
+#ifdef AIGER_HAVE_ZSTD
+  if (writer->zstd && !writer->error &&
+      !aiger_zstd_write (writer, 0, ZSTD_e_end))
+    res = 0;
+#endif
+
+  DELETEN (writer->block, AIGER_BLOCK_SIZE);
+
+  return res;
 }
 
 static int
 aiger_write_header (aiger * public,
 		    const char *format_string,
 		    int compact_inputs_and_latches,
-		    void *state, aiger_put put)
+		    aiger_writer * writer)
 {
   unsigned i, j;
 
-  if (aiger_put_s (state, put, format_string) == EOF) return 0;
-  if (put (' ', state) == EOF) return 0;
-  if (aiger_put_u (state, put, public->maxvar) == EOF) return 0;
-  if (put (' ', state) == EOF) return 0;
-  if (aiger_put_u (state, put, public->num_inputs) == EOF) return 0;
-  if (put (' ', state) == EOF) return 0;
-  if (aiger_put_u (state, put, public->num_latches) == EOF) return 0;
-  if (put (' ', state) == EOF) return 0;
-  if (aiger_put_u (state, put, public->num_outputs) == EOF) return 0;
-  if (put (' ', state) == EOF) return 0;
-  if (aiger_put_u (state, put, public->num_ands) == EOF) return 0;
+  if (aiger_put_s (writer, format_string) == EOF) return 0;
+  if (aiger_put_ch (writer, ' ') == EOF) return 0;
+  if (aiger_put_u (writer, public->maxvar) == EOF) return 0;
+  if (aiger_put_ch (writer, ' ') == EOF) return 0;
+  if (aiger_put_u (writer, public->num_inputs) == EOF) return 0;
+  if (aiger_put_ch (writer, ' ') == EOF) return 0;
+  if (aiger_put_u (writer, public->num_latches) == EOF) return 0;
+  if (aiger_put_ch (writer, ' ') == EOF) return 0;
+  if (aiger_put_u (writer, public->num_outputs) == EOF) return 0;
+  if (aiger_put_ch (writer, ' ') == EOF) return 0;
+  if (aiger_put_u (writer, public->num_ands) == EOF) return 0;
 
   if (public->num_bad ||
       public->num_constraints ||
       public->num_justice ||
       public->num_fairness)
     {
-      if (put (' ', state) == EOF) return 0;
-      if (aiger_put_u (state, put, public->num_bad) == EOF) return 0;
+      if (aiger_put_ch (writer, ' ') == EOF) return 0;
+      if (aiger_put_u (writer, public->num_bad) == EOF) return 0;
     }
 
   if (public->num_constraints ||
       public->num_justice ||
       public->num_fairness)
     {
-      if (put (' ', state) == EOF) return 0;
-      if (aiger_put_u (state, put, public->num_constraints) == EOF) return 0;
+      if (aiger_put_ch (writer, ' ') == EOF) return 0;
+      if (aiger_put_u (writer, public->num_constraints) == EOF) return 0;
     }
 
   if (public->num_justice ||
       public->num_fairness)
     {
-      if (put (' ', state) == EOF) return 0;
-      if (aiger_put_u (state, put, public->num_justice) == EOF) return 0;
+      if (aiger_put_ch (writer, ' ') == EOF) return 0;
+      if (aiger_put_u (writer, public->num_justice) == EOF) return 0;
     }
 
   if (public->num_fairness)
     {
-      if (put (' ', state) == EOF) return 0;
-      if (aiger_put_u (state, put, public->num_fairness) == EOF) return 0;
+      if (aiger_put_ch (writer, ' ') == EOF) return 0;
+      if (aiger_put_u (writer, public->num_fairness) == EOF) return 0;
     }
 
-  if (put ('\n', state) == EOF) return 0;
+  if (aiger_put_ch (writer, '\n') == EOF) return 0;
 
   if (!compact_inputs_and_latches && public->num_inputs)
     {
       for (i = 0; i < public->num_inputs; i++)
-	if (aiger_put_u (state, put, public->inputs[i].lit) == EOF ||
-	    put ('\n', state) == EOF)
+	if (aiger_put_u (writer, public->inputs[i].lit) == EOF ||
+	    aiger_put_ch (writer, '\n') == EOF)
 	  return 0;
     }
 
@@ -1032,45 +1567,45 @@ aiger_write_header (aiger * public,
 	{
 	  if (!compact_inputs_and_latches)
 	    {
-	      if (aiger_put_u (state, put, public->latches[i].lit) == EOF)
+	      if (aiger_put_u (writer, public->latches[i].lit) == EOF)
 	        return 0;
-	      if (put (' ', state) == EOF) return 0;
+	      if (aiger_put_ch (writer, ' ') == EOF) return 0;
 	    }
 
-	  if (aiger_put_u (state, put, public->latches[i].next) == EOF)
+	  if (aiger_put_u (writer, public->latches[i].next) == EOF)
 	     return 0;
 
 	  if (public->latches[i].reset) 
 	    {
-	      if (put (' ', state) == EOF) return 0;
-	      if (aiger_put_u (state, put, public->latches[i].reset) == EOF)
+	      if (aiger_put_ch (writer, ' ') == EOF) return 0;
+	      if (aiger_put_u (writer, public->latches[i].reset) == EOF)
 		return 0;
 	    }
-	  if (put ('\n', state) == EOF) return 0;
+	  if (aiger_put_ch (writer, '\n') == EOF) return 0;
 	}
     }
 
   if (public->num_outputs)
     {
       for (i = 0; i < public->num_outputs; i++)
-	if (aiger_put_u (state, put, public->outputs[i].lit) == EOF ||
-	    put ('\n', state) == EOF)
+	if (aiger_put_u (writer, public->outputs[i].lit) == EOF ||
+	    aiger_put_ch (writer, '\n') == EOF)
 	  return 0;
     }
 
   if (public->num_bad)
     {
       for (i = 0; i < public->num_bad; i++)
-	if (aiger_put_u (state, put, public->bad[i].lit) == EOF ||
-	    put ('\n', state) == EOF)
+	if (aiger_put_u (writer, public->bad[i].lit) == EOF ||
+	    aiger_put_ch (writer, '\n') == EOF)
 	  return 0;
     }
 
   if (public->num_constraints)
     {
       for (i = 0; i < public->num_constraints; i++)
-	if (aiger_put_u (state, put, public->constraints[i].lit) == EOF ||
-	    put ('\n', state) == EOF)
+	if (aiger_put_u (writer, public->constraints[i].lit) == EOF ||
+	    aiger_put_ch (writer, '\n') == EOF)
 	  return 0;
     }
 
@@ -1078,18 +1613,18 @@ aiger_write_header (aiger * public,
     {
       for (i = 0; i < public->num_justice; i++)
 	{
-	  if (aiger_put_u (state, put, public->justice[i].size) == EOF)
+	  if (aiger_put_u (writer, public->justice[i].size) == EOF)
 	    return 0;
-	  if (put ('\n', state) == EOF) return 0;
+	  if (aiger_put_ch (writer, '\n') == EOF) return 0;
 	}
 
       for (i = 0; i < public->num_justice; i++)
 	{
 	  for (j = 0; j < public->justice[i].size; j++)
 	    {
-	      if (aiger_put_u (state, put, public->justice[i].lits[j]) == EOF)
+	      if (aiger_put_u (writer, public->justice[i].lits[j]) == EOF)
 	        return 0;
-	      if (put ('\n', state) == EOF) return 0;
+	      if (aiger_put_ch (writer, '\n') == EOF) return 0;
 	    }
 	}
     }
@@ -1097,8 +1632,8 @@ aiger_write_header (aiger * public,
   if (public->num_fairness)
     {
       for (i = 0; i < public->num_fairness; i++)
-	if (aiger_put_u (state, put, public->fairness[i].lit) == EOF ||
-	    put ('\n', state) == EOF)
+	if (aiger_put_u (writer, public->fairness[i].lit) == EOF ||
+	    aiger_put_ch (writer, '\n') == EOF)
 	  return 0;
     }
 
@@ -1160,7 +1695,7 @@ aiger_have_at_least_one_symbol (aiger * public)
 
 static int
 aiger_write_symbols_aux (aiger * public,
-			 void *state, aiger_put put,
+			 aiger_writer * writer,
 			 const char *type,
 			 aiger_symbol * symbols, unsigned size)
 {
@@ -1173,11 +1708,11 @@ aiger_write_symbols_aux (aiger * public,
 
       assert (symbols[i].name[0]);
 
-      if (aiger_put_s (state, put, type) == EOF ||
-	  aiger_put_u (state, put, i) == EOF ||
-	  put (' ', state) == EOF ||
-	  aiger_put_s (state, put, symbols[i].name) == EOF ||
-	  put ('\n', state) == EOF)
+      if (aiger_put_s (writer, type) == EOF ||
+	  aiger_put_u (writer, i) == EOF ||
+	  aiger_put_ch (writer, ' ') == EOF ||
+	  aiger_put_s (writer, symbols[i].name) == EOF ||
+	  aiger_put_ch (writer, '\n') == EOF)
 	return 0;
     }
 
@@ -1185,34 +1720,34 @@ aiger_write_symbols_aux (aiger * public,
 }
 
 static int
-aiger_write_symbols (aiger * public, void *state, aiger_put put)
+aiger_write_symbols (aiger * public, aiger_writer * writer)
 {
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"i", public->inputs, public->num_inputs))
     return 0;
 
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"l", public->latches, public->num_latches))
     return 0;
 
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"o", public->outputs, public->num_outputs))
     return 0;
 
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"b", public->bad, public->num_bad))
     return 0;
 
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"c", public->constraints,
 				public->num_constraints))
     return 0;
 
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"j", public->justice, public->num_justice))
     return 0;
 
-  if (!aiger_write_symbols_aux (public, state, put,
+  if (!aiger_write_symbols_aux (public, writer,
 				"f", public->fairness, public->num_fairness))
     return 0;
 
@@ -1222,21 +1757,26 @@ aiger_write_symbols (aiger * public, void *state, aiger_put put)
 int
 aiger_write_symbols_to_file (aiger * public, FILE * file)
 {
+  IMPORT_private_FROM (public);
+  aiger_writer writer;
+
   assert (!aiger_error (public));
-  return aiger_write_symbols (public, file, (aiger_put) aiger_default_put);
+  aiger_init_writer (private, &writer, file, 0, 0);
+  return aiger_release_writer (private, &writer,
+			       aiger_write_symbols (public, &writer));
 }
 
 static int
-aiger_write_comments (aiger * public, void *state, aiger_put put)
+aiger_write_comments (aiger * public, aiger_writer * writer)
 {
   char **p, *str;
 
   for (p = public->comments; (str = *p); p++)
     {
-      if (aiger_put_s (state, put, str) == EOF)
+      if (aiger_put_s (writer, str) == EOF)
 	return 0;
 
-      if (put ('\n', state) == EOF)
+      if (aiger_put_ch (writer, '\n') == EOF)
 	return 0;
     }
 
@@ -1246,30 +1786,35 @@ aiger_write_comments (aiger * public, void *state, aiger_put put)
 int
 aiger_write_comments_to_file (aiger * public, FILE * file)
 {
+  IMPORT_private_FROM (public);
+  aiger_writer writer;
+
   assert (!aiger_error (public));
-  return aiger_write_comments (public, file, (aiger_put) aiger_default_put);
+  aiger_init_writer (private, &writer, file, 0, 0);
+  return aiger_release_writer (private, &writer,
+			       aiger_write_comments (public, &writer));
 }
 
 static int
-aiger_write_ascii (aiger * public, void *state, aiger_put put)
+aiger_write_ascii (aiger * public, aiger_writer * writer)
 {
   aiger_and *and;
   unsigned i;
 
   assert (!aiger_check (public));
 
-  if (!aiger_write_header (public, "aag", 0, state, put))
+  if (!aiger_write_header (public, "aag", 0, writer))
     return 0;
 
   for (i = 0; i < public->num_ands; i++)
     {
       and = public->ands + i;
-      if (aiger_put_u (state, put, and->lhs) == EOF ||
-	  put (' ', state) == EOF ||
-	  aiger_put_u (state, put, and->rhs0) == EOF ||
-	  put (' ', state) == EOF ||
-	  aiger_put_u (state, put, and->rhs1) == EOF ||
-	  put ('\n', state) == EOF)
+      if (aiger_put_u (writer, and->lhs) == EOF ||
+	  aiger_put_ch (writer, ' ') == EOF ||
+	  aiger_put_u (writer, and->rhs0) == EOF ||
+	  aiger_put_ch (writer, ' ') == EOF ||
+	  aiger_put_u (writer, and->rhs1) == EOF ||
+	  aiger_put_ch (writer, '\n') == EOF)
 	return 0;
     }
 
@@ -1306,8 +1851,15 @@ int
 aiger_is_reencoded (aiger * public)
 {
   unsigned i, tmp, max, lhs;
+  IMPORT_private_FROM (public);
   aiger_and *and;
 
+  if (aiger_decode_ands (public))
+    return 0;
+
+  if (private->reencoded)
+    return 1;
+
   max = 0;
   for (i = 0; i < public->num_inputs; i++)
     {
@@ -1345,6 +1897,8 @@ aiger_is_reencoded (aiger * public)
       lhs += 2;
     }
 
+  private->reencoded = 1;
+
   return 1;
 }
 
@@ -1465,20 +2019,13 @@ aiger_reencode_lit (aiger * public, unsigned lit,
   return code[lit];
 }
 
-static int
-cmp_lhs (const void *a, const void *b)
-{
-  const aiger_and *c = a;
-  const aiger_and *d = b;
-  return ((int) c->lhs) - (int) d->lhs;
-}
-
 void
 aiger_reencode (aiger * public)
 {
-  unsigned *code, i, j, size_code, old, new, lhs, rhs0, rhs1, tmp;
+  unsigned *code, i, j, size_code, old, new, lhs, rhs0, rhs1, tmp, pos;
   unsigned *stack, size_stack;
   IMPORT_private_FROM (public);
+  aiger_and swap;
 
   assert (!aiger_error (public));
 
@@ -1486,7 +2033,7 @@ aiger_reencode (aiger * public)
   aiger_type *type;
   aiger_and *and;
 
-  if (aiger_is_reencoded (public))
+  if (aiger_decode_ands (public) || aiger_is_reencoded (public))
     return;
 
   size_code = 2 * (public->maxvar + 1);
@@ -1602,13 +2149,29 @@ aiger_reencode (aiger * public)
     }
   public->num_ands = j;
 
-  qsort (public->ands, j, sizeof (*and), cmp_lhs);
-
-  assert (new);
-  assert (public->maxvar >= aiger_lit2var (new - 1));
-  public->maxvar = aiger_lit2var (new - 1);
+  /* The new AND indices are dense and start right after the latches, so
+   * the 'lhs' of each AND determines its final position.  Every swap puts
+   * one AND at its place, which replaces sorting by a linear permutation.
+   */
+  lhs = aiger_var2lit (public->num_inputs + public->num_latches + 1);
+  for (i = 0; i < j; i++)
+    {
+      for (;;)
+	{
+	  and = public->ands + i;
+	  assert (and->lhs >= lhs);
+	  pos = aiger_lit2var (and->lhs - lhs);
+	  assert (pos < j);
+	  if (pos == i)
+	    break;
+
+	  swap = public->ands[pos];
+	  public->ands[pos] = *and;
+	  *and = swap;
+	}
+    }
 
-  /* Reset types.
+  /* Reset types, also those of the indices beyond the new 'maxvar'.
    */
   for (i = 1; i <= public->maxvar; i++)
     {
@@ -1619,6 +2182,10 @@ aiger_reencode (aiger * public)
       type->idx = 0;
     }
 
+  assert (new);
+  assert (public->maxvar >= aiger_lit2var (new - 1));
+  public->maxvar = aiger_lit2var (new - 1);
+
   /* Fix types for ANDs.
    */
   for (i = 0; i < public->num_ands; i++)
@@ -1664,21 +2231,155 @@ aiger_reencode (aiger * public)
     }
 #endif
   assert (aiger_is_reencoded (public));
+  private->reencoded = 1;
   assert (!aiger_check (public));
 }
 
+static void
+aiger_coi_push (unsigned char *coi, unsigned *stack, unsigned *top_ptr,
+		unsigned lit)
+{
+  unsigned var = aiger_lit2var (lit);
+
+  if (!var || coi[var])
+    return;
+
+  coi[var] = 1;
+  stack[(*top_ptr)++] = var;
+}
+
 const unsigned char *
 aiger_coi (aiger * public)
 {
+  unsigned *stack, top, var, i, j;
   IMPORT_private_FROM (public);
+  aiger_type *type;
+  aiger_and *and;
+  unsigned char *coi;
+
+  if (aiger_decode_ands (public))
+    return 0;
+
+  DELETEN (private->coi, private->size_coi);
   private->size_coi = public->maxvar + 1;
   NEWN (private->coi, private->size_coi);
-  memset (private->coi, 1, private->size_coi);
+  coi = private->coi;
+
+  /* Every variable is pushed at most once, when it is marked.
+   */
+  NEWN (stack, public->maxvar + 1);
+  top = 0;
+
+  for (i = 0; i < public->num_outputs; i++)
+    aiger_coi_push (coi, stack, &top, public->outputs[i].lit);
+
+  for (i = 0; i < public->num_bad; i++)
+    aiger_coi_push (coi, stack, &top, public->bad[i].lit);
+
+  for (i = 0; i < public->num_constraints; i++)
+    aiger_coi_push (coi, stack, &top, public->constraints[i].lit);
+
+  for (i = 0; i < public->num_justice; i++)
+    for (j = 0; j < public->justice[i].size; j++)
+      aiger_coi_push (coi, stack, &top, public->justice[i].lits[j]);
+
+  for (i = 0; i < public->num_fairness; i++)
+    aiger_coi_push (coi, stack, &top, public->fairness[i].lit);
+
+  /* Reaching a latch adds the cone of its next state function, so the
+   * worklist is empty only at the sequential fixpoint.
+   */
+  while (top > 0)
+    {
+      var = stack[--top];
+      type = private->types + var;
+
+      if (type->and)
+	{
+	  and = public->ands + type->idx;
+	  aiger_coi_push (coi, stack, &top, and->rhs0);
+	  aiger_coi_push (coi, stack, &top, and->rhs1);
+	}
+      else if (type->latch)
+	aiger_coi_push (coi, stack, &top,
+			public->latches[type->idx].next);
+    }
+
+  DELETEN (stack, public->maxvar + 1);
+
   return private->coi;
 }
 
+void
+aiger_compact_coi (aiger * public)
+{
+  const unsigned char *coi;
+  IMPORT_private_FROM (public);
+  aiger_symbol *latch;
+  aiger_type *type;
+  aiger_and *and;
+  unsigned i, j;
+
+  coi = aiger_coi (public);
+  if (!coi)
+    return;
+
+  j = 0;
+  for (i = 0; i < public->num_latches; i++)
+    {
+      latch = public->latches + i;
+      type = private->types + aiger_lit2var (latch->lit);
+      if (!coi[aiger_lit2var (latch->lit)])
+	{
+	  aiger_delete_str (private, latch->name);
+	  type->latch = 0;
+	  type->idx = 0;
+	  continue;
+	}
+
+      type->idx = j;
+      public->latches[j++] = *latch;
+    }
+
+  if (j < public->num_latches)
+    {
+      memset (public->latches + j, 0,
+	      (public->num_latches - j) * sizeof (*latch));
+      public->num_latches = j;
+      private->reencoded = 0;
+    }
+
+  j = 0;
+  for (i = 0; i < public->num_ands; i++)
+    {
+      and = public->ands + i;
+      type = private->types + aiger_lit2var (and->lhs);
+      if (!coi[aiger_lit2var (and->lhs)])
+	{
+	  type->and = 0;
+	  type->idx = 0;
+	  continue;
+	}
+
+      type->idx = j;
+      public->ands[j++] = *and;
+    }
+
+  if (j < public->num_ands)
+    {
+      public->num_ands = j;
+      private->reencoded = 0;
+    }
+
+  DELETEN (private->coi, private->size_coi);
+
+  /* Closes the gaps the removed latches and ANDs left in the indices.
+   */
+  aiger_reencode (public);
+}
+
 static int
-aiger_write_binary (aiger * public, void *state, aiger_put put)
+aiger_write_binary (aiger * public, aiger_writer * writer)
 {
   aiger_and *and;
   unsigned lhs, i;
@@ -1687,7 +2388,7 @@ aiger_write_binary (aiger * public, void *state, aiger_put put)
 
   aiger_reencode (public);
 
-  if (!aiger_write_header (public, "aig", 1, state, put))
+  if (!aiger_write_header (public, "aig", 1, writer))
     return 0;
 
   lhs = aiger_max_input_or_latch (public) + 2;
@@ -1700,10 +2401,10 @@ aiger_write_binary (aiger * public, void *state, aiger_put put)
       assert (lhs > and->rhs0);
       assert (and->rhs0 >= and->rhs1);
 
-      if (!aiger_write_delta (state, put, lhs - and->rhs0))
+      if (!aiger_write_delta (writer, lhs - and->rhs0))
 	return 0;
 
-      if (!aiger_write_delta (state, put, and->rhs0 - and->rhs1))
+      if (!aiger_write_delta (writer, and->rhs0 - and->rhs1))
 	return 0;
 
       lhs += 2;
@@ -1746,20 +2447,21 @@ aiger_strip_symbols_and_comments (aiger * public)
   return res;
 }
 
-int
-aiger_write_generic (aiger * public,
-		     aiger_mode mode, void *state, aiger_put put)
+static int
+aiger_write_with_writer (aiger * public, aiger_mode mode,
+			 aiger_writer * writer)
 {
-  assert (!aiger_error (public));
+  if (aiger_decode_ands (public))
+    return 0;
 
   if ((mode & aiger_ascii_mode))
     {
-      if (!aiger_write_ascii (public, state, put))
+      if (!aiger_write_ascii (public, writer))
 	return 0;
     }
   else
     {
-      if (!aiger_write_binary (public, state, put))
+      if (!aiger_write_binary (public, writer))
 	return 0;
     }
 
@@ -1767,16 +2469,16 @@ aiger_write_generic (aiger * public,
     {
       if (aiger_have_at_least_one_symbol (public))
 	{
-	  if (!aiger_write_symbols (public, state, put))
+	  if (!aiger_write_symbols (public, writer))
 	    return 0;
 	}
 
       if (public->comments[0])
 	{
-	  if (aiger_put_s (state, put, "c\n") == EOF)
+	  if (aiger_put_s (writer, "c\n") == EOF)
 	    return 0;
 
-	  if (!aiger_write_comments (public, state, put))
+	  if (!aiger_write_comments (public, writer))
 	    return 0;
 	}
     }
@@ -1784,12 +2486,31 @@ aiger_write_generic (aiger * public,
   return 1;
 }
 
+int
+aiger_write_generic (aiger * public,
+		     aiger_mode mode, void *state, aiger_put put)
+{
+  IMPORT_private_FROM (public);
+  aiger_writer writer;
+
+  assert (!aiger_error (public));
+  aiger_init_writer (private, &writer, 0, state, put);
+  return aiger_release_writer (private, &writer,
+			       aiger_write_with_writer (public, mode,
+							&writer));
+}
+
 int
 aiger_write_to_file (aiger * public, aiger_mode mode, FILE * file)
 {
+  IMPORT_private_FROM (public);
+  aiger_writer writer;
+
   assert (!aiger_error (public));
-  return aiger_write_generic (public,
-			      mode, file, (aiger_put) aiger_default_put);
+  aiger_init_writer (private, &writer, file, 0, 0);
+  return aiger_release_writer (private, &writer,
+			       aiger_write_with_writer (public, mode,
+							&writer));
 }
 
 int
@@ -1824,12 +2545,100 @@ aiger_has_suffix (const char *str, const char *suffix)
   return !strcmp (str + strlen (str) - strlen (suffix), suffix);
 }
 
+#if !defined(AIGER_HAVE_ZLIB) || !defined(AIGER_HAVE_ZSTD)
+/* Open a pipe through the command 'fmt' applied to 'file_name', which is
+ * used for compressed files if the library can not do it in process.
+ */
+static FILE *
+aiger_popen (aiger * public, const char *fmt,
+	     const char *file_name, const char *type)
+{
+  IMPORT_private_FROM (public);
+  size_t size_cmd;
+  FILE *res;
+  char *cmd;
+
+  size_cmd = strlen (file_name) + strlen (fmt);
+  NEWN (cmd, size_cmd);
+  sprintf (cmd, fmt, file_name);
+  res = popen (cmd, type);
+  DELETEN (cmd, size_cmd);
+
+  return res;
+}
+#endif
+
+#ifdef AIGER_HAVE_ZLIB
+static int
+aiger_open_and_write_to_gz (aiger * public, aiger_mode mode,
+			    const char *file_name)
+{
+  IMPORT_private_FROM (public);
+  aiger_writer writer;
+  gzFile gz;
+  int res;
+
+  gz = gzopen (file_name, "wb");
+  if (!gz)
+    return 0;
+
+  aiger_init_writer (private, &writer, 0, 0, 0);
+  writer.gz = gz;
+  res = aiger_release_writer (private, &writer,
+			      aiger_write_with_writer (public, mode,
+						       &writer));
+  if (gzclose (gz) != Z_OK)
+    res = 0;
+
+  return res;
+}
+#endif
+
+#ifdef AIGER_HAVE_ZSTD
+static int
+aiger_open_and_write_to_zstd (aiger * public, aiger_mode mode,
+			      const char *file_name)
+{
+  IMPORT_private_FROM (public);
+  aiger_writer writer;
+  ZSTD_CStream *zstd;
+  FILE *file;
+  int res;
+
+  file = fopen (file_name, "wb");
+  if (!file)
+    return 0;
+
+  zstd = ZSTD_createCStream ();
+  if (!zstd)
+    {
+      fclose (file);
+      return 0;
+    }
+
+  /* Add a checksum, as the 'zstd' program does.
+   */
+  ZSTD_CCtx_setParameter (zstd, ZSTD_c_checksumFlag, 1);
+
+  aiger_init_writer (private, &writer, file, 0, 0);
+  writer.zstd = zstd;
+  NEWN (writer.zblock, AIGER_BLOCK_SIZE);
+  res = aiger_release_writer (private, &writer,
+			      aiger_write_with_writer (public, mode,
+						       &writer));
+  DELETEN (writer.zblock, AIGER_BLOCK_SIZE);
+  ZSTD_freeCStream (zstd);
+  if (fclose (file))
+    res = 0;
+
+  return res;
+}
+#endif
+
 int
 aiger_open_and_write_to_file (aiger * public, const char *file_name)
 {
-  IMPORT_private_FROM (public);
   int res, pclose_file;
-  char *cmd, size_cmd;
   aiger_mode mode;
   FILE *file;
 
@@ -1837,14 +2646,36 @@ aiger_open_and_write_to_file (aiger * public, const char *file_name)
 
   assert (file_name);
 
+  if (aiger_has_suffix (file_name, ".aag") ||
+      aiger_has_suffix (file_name, ".aag.gz") ||
+      aiger_has_suffix (file_name, ".aag.zst"))
+    mode = aiger_ascii_mode;
+  else
+    mode = aiger_binary_mode;
+
   if (aiger_has_suffix (file_name, ".gz"))
     {
-      size_cmd = strlen (file_name) + strlen (GZIP);
-      NEWN (cmd, size_cmd);
-      sprintf (cmd, GZIP, file_name);
-      file = popen (cmd, "w");
-      DELETEN (cmd, size_cmd);
+#ifdef AIGER_HAVE_ZLIB
+      res = aiger_open_and_write_to_gz (public, mode, file_name);
+      if (!res)
+	unlink (file_name);
+      return res;
+#else
+      file = aiger_popen (public, GZIP, file_name, "w");
       pclose_file = 1;
+#endif
+    }
+  else if (aiger_has_suffix (file_name, ".zst"))
+    {
+#ifdef AIGER_HAVE_ZSTD
+      res = aiger_open_and_write_to_zstd (public, mode, file_name);
+      if (!res)
+	unlink (file_name);
+      return res;
+#else
+      file = aiger_popen (public, ZSTD, file_name, "w");
+      pclose_file = 1;
+#endif
     }
   else
     {
@@ -1855,12 +2686,6 @@ aiger_open_and_write_to_file (aiger * public, const char *file_name)
   if (!file)
     return 0;
 
-  if (aiger_has_suffix (file_name, ".aag") ||
-      aiger_has_suffix (file_name, ".aag.gz"))
-    mode = aiger_ascii_mode;
-  else
-    mode = aiger_binary_mode;
-
   res = aiger_write_to_file (public, mode, file);
 
   if (pclose_file)
@@ -1874,12 +2699,113 @@ aiger_open_and_write_to_file (aiger * public, const char *file_name)
   return res;
 }
 
+#ifdef AIGER_HAVE_ZSTD
+/* Decompress into the block, reading more compressed bytes from the file
+ * only when the decoder can not make progress without them.
+ */
+static size_t
+aiger_zstd_read (aiger_reader * reader)
+{
+  ZSTD_outBuffer out;
+  size_t left, pos;
+
+  out.dst = reader->block;
+  out.size = AIGER_BLOCK_SIZE;
+  out.pos = 0;
+
+  if (reader->zerror)
+    return 0;
+
+  for (;;)
+    {
+      pos = reader->zin.pos;
+      left = ZSTD_decompressStream (reader->zstd, &out, &reader->zin);
+      if (ZSTD_isError (left))
+	{
+	  reader->zerror = ZSTD_getErrorName (left);
+	  break;
+	}
+
+      if (out.pos || reader->zin.pos > pos)
+	reader->zleft = left;
+
+      if (out.pos)
+	break;
+
+      if (reader->zin.pos < reader->zin.size)
+	continue;
+
+      reader->zin.size = fread ((void *) reader->zin.src, 1,
+				AIGER_BLOCK_SIZE, reader->file);
+      reader->zin.pos = 0;
+      if (!reader->zin.size)
+	{
+	  if (ferror (reader->file))
+	    reader->zerror = "read error";
+	  else if (reader->zleft)
+	    reader->zerror = "unexpected end of file";
+	  break;
+	}
+    }
+
+  return out.pos;
+}
+#endif
+
+static int
+aiger_refill (aiger_reader * reader)
+{
+  size_t bytes;
+#ifdef AIGER_HAVE_ZLIB
+  int res, errnum;
+  const char *msg;
+#endif
+
+#ifdef AIGER_HAVE_ZLIB
+  if (reader->gz)
+    {
+      res = reader->zerror ? 0 :
+	gzread (reader->gz, reader->block, AIGER_BLOCK_SIZE);
+      bytes = res > 0 ? res : 0;
+      if (!bytes && !reader->zerror)
+	{
+	  msg = gzerror (reader->gz, &errnum);
+	  if (errnum != Z_OK)
+	    reader->zerror = errnum == Z_ERRNO ? "read error" : msg;
+	}
+    }
+  else
+#endif
+#ifdef AIGER_HAVE_ZSTD
+  if (reader->zstd)
+    bytes = aiger_zstd_read (reader);
+  else
+#endif
+  if (reader->file)
+    bytes = fread (reader->block, 1, AIGER_BLOCK_SIZE, reader->file);
+  else
+    bytes = 0;
+
+  if (!bytes)
+    return EOF;
+
+  reader->cursor = reader->block;
+  reader->end = reader->block + bytes;
+
+  return *reader->cursor++;
+}
+
 static int
 aiger_next_ch (aiger_reader * reader)
 {
   int res;
 
-  res = reader->get (reader->state);
+  if (reader->cursor < reader->end)
+    res = *reader->cursor++;
+  else if (reader->buffered)
+    res = aiger_refill (reader);
+  else
+    res = reader->get (reader->state);
 
   if (isspace (reader->ch) && !isspace (res))
     reader->lineno_at_last_token_start = reader->lineno;
@@ -1912,8 +2838,23 @@ aiger_read_number (aiger_reader * reader)
   assert (isdigit (reader->ch));
   res = reader->ch - '0';
 
-  while (isdigit (aiger_next_ch (reader)))
-    res = 10 * res + (reader->ch - '0');
+  for (;;)
+    {
+      /* Digits are not white space and do not end a line, so while they
+       * are in the block only the character count needs to be updated.
+       */
+      while (reader->cursor < reader->end && isdigit (*reader->cursor))
+	{
+	  reader->ch = *reader->cursor++;
+	  reader->charno++;
+	  res = 10 * res + (reader->ch - '0');
+	}
+
+      if (!isdigit (aiger_next_ch (reader)))
+	break;
+
+      res = 10 * res + (reader->ch - '0');
+    }
 
   return res;
 }
@@ -2328,10 +3269,171 @@ aiger_read_delta (aiger_private * private, aiger_reader * reader,
   return 0;
 }
 
+/* Decode the two deltas of an AND and the character after them directly
+ * from the block, which has to hold at least 12 more characters.  A delta
+ * takes up to 6 bytes, the first of which is already in 'reader->ch', so
+ * up to 5 more for the first delta, 6 for the second and one for the
+ * character after it are taken from the block.  The character
+ * number of the start of the second delta is stored in 'second'.  Returns
+ * zero for an invalid code, which is then left to 'aiger_read_delta' to
+ * report.  The position of the last token start is only updated after the
+ * whole AND section (see 'aiger_read_binary').
+ */
+static int
+aiger_read_deltas_from_block (aiger_reader * reader,
+			      unsigned *deltas, unsigned *second)
+{
+  const unsigned char *p, *q;
+  unsigned ch, res, shift, j;
+
+  p = reader->cursor;
+  ch = reader->ch;
+  for (j = 0; j < 2; j++)
+    {
+      res = 0;
+      shift = 0;
+      while (ch & 0x80)
+	{
+	  if (shift == 35)
+	    return 0;
+	  res |= (ch & 0x7f) << shift;
+	  shift += 7;
+	  ch = *p++;
+	}
+      if (shift == 35 && ch >= 8)
+	return 0;
+      deltas[j] = res | (ch << shift);
+      ch = *p++;
+      if (!j)
+	*second = reader->charno + (p - reader->cursor);
+    }
+
+  for (q = reader->cursor; q < p; q++)
+    {
+      reader->lineno += (*q == '\n');
+      if (reader->looks_like_aag && !isspace (*q) && !isdigit (*q))
+	reader->looks_like_aag = 0;
+    }
+
+  reader->ch = ch;
+  reader->charno += p - reader->cursor;
+  reader->cursor = p;
+
+  return 1;
+}
+
+/* Number of bytes checked at once for single byte deltas, see
+ * 'aiger_read_short_deltas'.
+ */
+#if defined(__AVX2__)
+#define AIGER_DELTA_WINDOW 32
+#else
+#define AIGER_DELTA_WINDOW 16
+#endif
+
+/* Non zero if none of the AIGER_DELTA_WINDOW bytes at 'p' has its
+ * continuation bit set, with SIMD instructions if available.
+ */
+static int
+aiger_no_continuation (const unsigned char *p)
+{
+#if defined(__AVX2__)
+  return !_mm256_movemask_epi8 (_mm256_loadu_si256 ((const __m256i *) p));
+#elif defined(__SSE2__)
+  return !_mm_movemask_epi8 (_mm_loadu_si128 ((const __m128i *) p));
+#else
+  uint64_t words[AIGER_DELTA_WINDOW / 8], bits;
+  unsigned i;
+
+  memcpy (words, p, sizeof (words));
+  bits = 0;
+  for (i = 0; i < AIGER_DELTA_WINDOW / 8; i++)
+    bits |= words[i];
+
+  return !(bits & 0x8080808080808080ull);
+#endif
+}
+
+/* Most deltas fit into a single byte.  If the next AIGER_DELTA_WINDOW
+ * bytes of the block (starting with the current character) are all such
+ * deltas, the corresponding ANDs are stored directly into 'public->ands',
+ * which the header already made large enough, without 'aiger_add_and'.
+ * The previous AND has the LHS 'lhs' and at most 'max_ands' are decoded.
+ * Decoding stops before an invalid delta, which is then left to the
+ * general path to report.  Returns the number of ANDs decoded.
+ */
+static unsigned
+aiger_read_short_deltas (aiger * public, aiger_reader * reader,
+			 unsigned lhs, unsigned max_ands)
+{
+  IMPORT_private_FROM (public);
+  const unsigned char *p, *q;
+  unsigned k, n, rhs0;
+  aiger_type *type;
+  aiger_and *and;
+
+  if (reader->end - reader->cursor < AIGER_DELTA_WINDOW)
+    return 0;
+
+  p = reader->cursor - 1;
+  assert (*p == reader->ch);
+
+  if (!aiger_no_continuation (p))
+    return 0;
+
+  n = AIGER_DELTA_WINDOW / 2;
+  if (n > max_ands)
+    n = max_ands;
+
+  assert (public->num_ands + n <= private->size_ands);
+  and = public->ands + public->num_ands;
+
+  for (k = 0; k < n; k++)
+    {
+      lhs += 2;
+      if (p[2 * k] > lhs)
+	break;
+      rhs0 = lhs - p[2 * k];
+      if (p[2 * k + 1] > rhs0)
+	break;
+
+      assert (aiger_lit2var (lhs) < private->size_types);
+      type = private->types + aiger_lit2var (lhs);
+      type->and = 1;
+      type->idx = public->num_ands + k;
+
+      and[k].lhs = lhs;
+      and[k].rhs0 = rhs0;
+      and[k].rhs1 = rhs0 - p[2 * k + 1];
+    }
+
+  if (!k)
+    return 0;
+
+  /* The ANDs are in binary order, thus 'private->reencoded' stays valid.
+   */
+  public->num_ands += k;
+
+  /* the characters fetched, the last one is the next current character */
+  for (q = p + 1; q <= p + 2 * k; q++)
+    {
+      reader->lineno += (*q == '\n');
+      if (reader->looks_like_aag && !isspace (*q) && !isdigit (*q))
+	reader->looks_like_aag = 0;
+    }
+
+  reader->ch = p[2 * k];
+  reader->cursor = p + 2 * k + 1;
+  reader->charno += 2 * k;
+
+  return k;
+}
+
 static const char *
 aiger_read_binary (aiger * public, aiger_reader * reader)
 {
   unsigned i, lhs, rhs0, rhs1, delta, charno;
+  unsigned deltas[2], second, done;
   IMPORT_private_FROM (public);
   const char *error;
 
@@ -2341,8 +3443,35 @@ aiger_read_binary (aiger * public, aiger_reader * reader)
 
   for (i = 0; i < reader->ands; i++)
     {
+      if (reader->buffered && reader->ch != EOF &&
+	  (done = aiger_read_short_deltas (public, reader, lhs,
+					   reader->ands - i)))
+	{
+	  lhs += 2 * done;
+	  i += done - 1;
+	  continue;
+	}
+
       lhs += 2;
       charno = reader->charno;
+
+      if (reader->buffered && reader->ch != EOF &&
+	  reader->end - reader->cursor >= 12 &&
+	  aiger_read_deltas_from_block (reader, deltas, &second))
+	{
+	  if (deltas[0] > lhs)
+	    goto INVALID_DELTA;
+	  rhs0 = lhs - deltas[0];
+
+	  charno = second;
+	  if (deltas[1] > rhs0)
+	    goto INVALID_DELTA;
+	  rhs1 = rhs0 - deltas[1];
+
+	  aiger_add_and (public, lhs, rhs0, rhs1);
+	  continue;
+	}
+
       error = aiger_read_delta (private, reader, &delta);
       if (error)
 	return error;
@@ -2366,6 +3495,12 @@ aiger_read_binary (aiger * public, aiger_reader * reader)
       aiger_add_and (public, lhs, rhs0, rhs1);
     }
 
+  /* Line numbers only count new line characters in the binary section,
+   * so we simply let the next token start on the current line.
+   */
+  if (reader->buffered)
+    reader->lineno_at_last_token_start = reader->lineno;
+
   return 0;
 }
 
@@ -2412,9 +3547,13 @@ aiger_read_symbols_and_comments (aiger * public, aiger_reader * reader)
   const char *error, *type;
   unsigned pos, num, count;
   aiger_symbol *symbol;
+  int keep;
   
   assert (!reader->buffer);
 
+  if (private->read_mode == aiger_read_no_symbols)
+    return 0;
+
   for (count = 0;; count++)
     {
       if (reader->ch == EOF)
@@ -2443,19 +3582,28 @@ aiger_read_symbols_and_comments (aiger * public, aiger_reader * reader)
       if (reader->ch == 'c')
 	{	  
 	  if ( aiger_next_ch (reader) == '\n' )
-	    return aiger_read_comments(public, reader);
+	    {
+	      if (private->read_mode != aiger_read_all)
+		return 0;
+
+	      return aiger_read_comments(public, reader);
+	    }
 
 	  type = "constraint";
 	  num = public->num_constraints;
 	  symbol = public->constraints;
+	  keep = (private->read_mode != aiger_read_input_symbols);
 	}
       else 
 	{
+	  keep = (private->read_mode != aiger_read_input_symbols);
+
 	  if (reader->ch == 'i')
 	    {
 	      type = "input";
 	      num = public->num_inputs;
 	      symbol = public->inputs;
+	      keep = 1;
 	    }
 	  else if (reader->ch == 'l')
 	    {
@@ -2513,7 +3661,8 @@ aiger_read_symbols_and_comments (aiger * public, aiger_reader * reader)
 
       while (reader->ch != '\n' && reader->ch != EOF)
 	{
-	  aiger_reader_push_ch (private, reader, reader->ch);
+	  if (keep)
+	    aiger_reader_push_ch (private, reader, reader->ch);
 	  aiger_next_ch (reader);
 	}
 
@@ -2524,62 +3673,337 @@ aiger_read_symbols_and_comments (aiger * public, aiger_reader * reader)
       assert (reader->ch == '\n');
       aiger_next_ch (reader);
 
+      if (!keep)
+	continue;
+
       aiger_reader_push_ch (private, reader, 0);
       symbol->name = aiger_copy_str (private, reader->buffer);
       reader->top_buffer = 0;
     }
 }
 
+/* Locate the binary AND section in a mapped file without decoding it, by
+ * counting the last bytes of its 2 * 'ands' deltas, and continue reading
+ * after it.  Returns zero if the section is truncated, so that decoding it
+ * right away gives the proper error message.
+ */
+static int
+aiger_skip_binary (aiger * public, aiger_reader * reader)
+{
+  IMPORT_private_FROM (public);
+  const unsigned char *start, *p;
+  unsigned lines;
+  size_t needed;
+  int aag;
+
+  if (!reader->ands || reader->ch == EOF)
+    return 0;
+
+  start = reader->cursor - 1;
+  assert (*start == reader->ch);
+
+  needed = 2 * (size_t) reader->ands;
+  needed -= !(*start & 0x80);
+
+  lines = 0;
+  aag = 1;
+  for (p = start + 1; needed && p < reader->end; p++)
+    {
+      needed -= !(*p & 0x80);
+      lines += (*p == '\n');
+      aag &= (isspace (*p) || isdigit (*p));
+    }
+
+  if (needed)
+    return 0;
+
+  private->lazy_ands = start;
+  private->size_lazy_ands = p - start;
+  private->num_lazy_ands = reader->ands;
+  private->lazy_lineno = reader->lineno;
+  private->lazy_charno = reader->charno;
+
+  /* Same as after reading the deltas character by character.
+   */
+  reader->cursor = p;
+  reader->charno += p - start - 1;
+  reader->lineno += lines;
+  if (!aag)
+    reader->looks_like_aag = 0;
+  aiger_next_ch (reader);
+  reader->lineno_at_last_token_start = reader->lineno;
+
+  return 1;
+}
+
+static void
+aiger_unmap (aiger_private * private)
+{
+  if (!private->map)
+    return;
+
+  munmap (private->map, private->size_map);
+  private->map = 0;
+  private->lazy_ands = 0;
+}
+
 const char *
-aiger_read_generic (aiger * public, void *state, aiger_get get)
+aiger_decode_ands (aiger * public)
 {
   IMPORT_private_FROM (public);
   aiger_reader reader;
   const char *error;
 
-  assert (!aiger_error (public));
+  if (!private->lazy_ands)
+    return private->error;
 
   CLR (reader);
 
-  reader.lineno = 1;
-  reader.state = state;
-  reader.get = get;
-  reader.ch = ' ';
+  reader.buffered = 1;
+  reader.cursor = private->lazy_ands + 1;
+  reader.end = private->lazy_ands + private->size_lazy_ands;
+  reader.ch = private->lazy_ands[0];
+  reader.lineno = private->lazy_lineno;
+  reader.charno = private->lazy_charno;
+  reader.done_with_reading_header = 1;
+  reader.mode = aiger_binary_mode;
+  reader.ands = private->num_lazy_ands;
+
+  /* Taken first, since adding ANDs decodes pending ones.
+   */
+  private->lazy_ands = 0;
 
-  error = aiger_read_header (public, &reader);
+  error = aiger_read_binary (public, &reader);
+  aiger_unmap (private);
   if (error)
     return error;
 
-  if (reader.mode == aiger_ascii_mode)
-    error = aiger_read_ascii (public, &reader);
-  else
-    error = aiger_read_binary (public, &reader);
+  return aiger_check (public);
+}
+
+void
+aiger_set_read_mode (aiger * public, aiger_read_mode mode)
+{
+  IMPORT_private_FROM (public);
+  private->read_mode = mode;
+}
+
+static const char *
+aiger_read_with_reader (aiger * public, aiger_reader * reader)
+{
+  IMPORT_private_FROM (public);
+  const char *error;
+
+  reader->lineno = 1;
+  reader->ch = ' ';
+
+  error = aiger_read_header (public, reader);
+  if (error)
+    return error;
+
+  if (reader->mode == aiger_ascii_mode)
+    error = aiger_read_ascii (public, reader);
+  else if (!reader->lazy || !aiger_skip_binary (public, reader))
+    error = aiger_read_binary (public, reader);
 
   if (error)
     return error;
 
-  error = aiger_read_symbols_and_comments (public, &reader);
+  error = aiger_read_symbols_and_comments (public, reader);
 
-  DELETEN (reader.buffer, reader.size_buffer);
+  DELETEN (reader->buffer, reader->size_buffer);
 
   if (error)
     return error;
 
+  /* Checked after decoding the ANDs instead.
+   */
+  if (private->lazy_ands)
+    return 0;
+
   return aiger_check (public);
 }
 
+const char *
+aiger_read_generic (aiger * public, void *state, aiger_get get)
+{
+  aiger_reader reader;
+
+  assert (!aiger_error (public));
+
+  CLR (reader);
+
+  reader.state = state;
+  reader.get = get;
+
+  return aiger_read_with_reader (public, &reader);
+}
+
 const char *
 aiger_read_from_file (aiger * public, FILE * file)
 {
+  IMPORT_private_FROM (public);
+  aiger_reader reader;
+  const char *error;
+
+  assert (!aiger_error (public));
+
+  CLR (reader);
+
+  reader.buffered = 1;
+  reader.file = file;
+  NEWN (reader.block, AIGER_BLOCK_SIZE);
+
+  error = aiger_read_with_reader (public, &reader);
+
+  DELETEN (reader.block, AIGER_BLOCK_SIZE);
+
+  return error;
+}
+
+const char *
+aiger_read_from_buffer (aiger * public, const char *bytes, size_t size)
+{
+  aiger_reader reader;
+
   assert (!aiger_error (public));
-  return aiger_read_generic (public, file, (aiger_get) aiger_default_get);
+
+  CLR (reader);
+
+  reader.buffered = 1;
+  reader.cursor = (const unsigned char *) bytes;
+  reader.end = reader.cursor + size;
+
+  return aiger_read_with_reader (public, &reader);
+}
+
+#if defined(AIGER_HAVE_ZLIB) || defined(AIGER_HAVE_ZSTD)
+/* Decode the rest of a compressed file after reading, so that its
+ * checksum is verified even if reading stopped early at corrupted data.
+ */
+static void
+aiger_drain (aiger_reader * reader)
+{
+  while (!reader->zerror && aiger_refill (reader) != EOF)
+    ;
+}
+
+/* Report that 'file_name' could not be decompressed because of 'reason'.
+ * This replaces the error, if any, which the reader ran into since the
+ * corrupted data ended the file early or was parsed.
+ */
+static const char *
+aiger_decompress_error (aiger_private * private,
+			const char *file_name, const char *reason)
+{
+  const char *fmt = "can not decompress '%s': %s";
+  size_t tmp_len, len;
+  char *tmp;
+
+  /* Messages of 'gzerror' start with the file name.
+   */
+  len = strlen (file_name);
+  if (!strncmp (reason, file_name, len) && !strncmp (reason + len, ": ", 2))
+    reason += len + 2;
+
+  aiger_delete_str (private, private->error);
+  tmp_len = strlen (fmt) + strlen (file_name) + strlen (reason) + 1;
+  NEWN (tmp, tmp_len);
+  sprintf (tmp, fmt, file_name, reason);
+  private->error = aiger_copy_str (private, tmp);
+  DELETEN (tmp, tmp_len);
+  return private->error;
+}
+#endif
+
+#ifdef AIGER_HAVE_ZLIB
+static const char *
+aiger_open_and_read_from_gz (aiger * public, const char *file_name)
+{
+  IMPORT_private_FROM (public);
+  aiger_reader reader;
+  const char *error;
+  gzFile gz;
+  int res;
+
+  gz = gzopen (file_name, "rb");
+  if (!gz)
+    return aiger_error_s (private, "can not read '%s'", file_name);
+
+  CLR (reader);
+
+  reader.buffered = 1;
+  reader.gz = gz;
+  NEWN (reader.block, AIGER_BLOCK_SIZE);
+
+  error = aiger_read_with_reader (public, &reader);
+  aiger_drain (&reader);
+
+  /* The message of 'gzerror' is only valid until 'gzclose'.
+   */
+  if (reader.zerror)
+    error = aiger_decompress_error (private, file_name, reader.zerror);
+
+  DELETEN (reader.block, AIGER_BLOCK_SIZE);
+  res = gzclose (gz);
+  if (res != Z_OK && !reader.zerror)
+    error = aiger_decompress_error (private, file_name,
+				    res == Z_ERRNO ? "read error" :
+				    zError (res));
+
+  return error;
+}
+#endif
+
+#ifdef AIGER_HAVE_ZSTD
+static const char *
+aiger_open_and_read_from_zstd (aiger * public, const char *file_name)
+{
+  IMPORT_private_FROM (public);
+  aiger_reader reader;
+  const char *error;
+  char *zblock;
+  FILE *file;
+
+  file = fopen (file_name, "rb");
+  if (!file)
+    return aiger_error_s (private, "can not read '%s'", file_name);
+
+  CLR (reader);
+
+  reader.zleft = 1;
+  reader.zstd = ZSTD_createDStream ();
+  if (!reader.zstd)
+    {
+      fclose (file);
+      return aiger_error_s (private, "can not decompress '%s'", file_name);
+    }
+  ZSTD_initDStream (reader.zstd);
+
+  reader.buffered = 1;
+  reader.file = file;
+  NEWN (reader.block, AIGER_BLOCK_SIZE);
+  NEWN (zblock, AIGER_BLOCK_SIZE);
+  reader.zin.src = zblock;
+
+  error = aiger_read_with_reader (public, &reader);
+  aiger_drain (&reader);
+  if (reader.zerror)
+    error = aiger_decompress_error (private, file_name, reader.zerror);
+
+  DELETEN (zblock, AIGER_BLOCK_SIZE);
+  DELETEN (reader.block, AIGER_BLOCK_SIZE);
+  ZSTD_freeDStream (reader.zstd);
+  fclose (file);
+
+  return error;
 }
+#endif
 
 const char *
 aiger_open_and_read_from_file (aiger * public, const char *file_name)
 {
   IMPORT_private_FROM (public);
-  char *cmd, size_cmd;
   const char *res;
   int pclose_file;
   FILE *file;
@@ -2588,12 +4012,21 @@ aiger_open_and_read_from_file (aiger * public, const char *file_name)
 
   if (aiger_has_suffix (file_name, ".gz"))
     {
-      size_cmd = strlen (file_name) + strlen (GUNZIP);
-      NEWN (cmd, size_cmd);
-      sprintf (cmd, GUNZIP, file_name);
-      file = popen (cmd, "r");
-      DELETEN (cmd, size_cmd);
+#ifdef AIGER_HAVE_ZLIB
+      return aiger_open_and_read_from_gz (public, file_name);
+#else
+      file = aiger_popen (public, GUNZIP, file_name, "r");
+      pclose_file = 1;
+#endif
+    }
+  else if (aiger_has_suffix (file_name, ".zst"))
+    {
+#ifdef AIGER_HAVE_ZSTD
+      return aiger_open_and_read_from_zstd (public, file_name);
+#else
+      file = aiger_popen (public, UNZSTD, file_name, "r");
       pclose_file = 1;
+#endif
     }
   else
     {
@@ -2614,6 +4047,59 @@ aiger_open_and_read_from_file (aiger * public, const char *file_name)
   return res;
 }
 
+const char *
+aiger_open_and_map (aiger * public, const char *file_name, int lazy)
+{
+  IMPORT_private_FROM (public);
+  aiger_reader reader;
+  const char *error;
+  struct stat st;
+  void *map;
+  int fd;
+
+  assert (!aiger_error (public));
+  assert (!private->map);
+
+  if (aiger_has_suffix (file_name, ".gz") ||
+      aiger_has_suffix (file_name, ".zst"))
+    return aiger_open_and_read_from_file (public, file_name);
+
+  fd = open (file_name, O_RDONLY);
+  if (fd < 0)
+    return aiger_error_s (private, "can not read '%s'", file_name);
+
+  /* Empty or special files can not be mapped, so read them as usual.
+   */
+  map = MAP_FAILED;
+  if (!fstat (fd, &st) && S_ISREG (st.st_mode) && st.st_size > 0)
+    map = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+
+  if (map == MAP_FAILED)
+    return aiger_open_and_read_from_file (public, file_name);
+
+#ifdef MADV_SEQUENTIAL
+  madvise (map, st.st_size, MADV_SEQUENTIAL);
+#endif
+
+  private->map = map;
+  private->size_map = st.st_size;
+
+  CLR (reader);
+
+  reader.buffered = 1;
+  reader.cursor = map;
+  reader.end = reader.cursor + st.st_size;
+  reader.lazy = lazy;
+
+  error = aiger_read_with_reader (public, &reader);
+
+  if (!private->lazy_ands)
+    aiger_unmap (private);
+
+  return error;
+}
+
 const char *
 aiger_get_symbol (aiger * public, unsigned lit)
 {
@@ -2706,7 +4192,9 @@ aiger_is_and (aiger * public, unsigned lit)
   aiger_type *type;
   aiger_and *res;
 
-  assert (!aiger_error (public));
+  if (aiger_decode_ands (public))
+    return 0;
+
   type = aiger_lit2type (public, lit);
   if (!type->and)
     return 0;
@@ -105,6 +105,20 @@ enum aiger_mode
 
 typedef enum aiger_mode aiger_mode;
 
+/*------------------------------------------------------------------------*/
+/* What the readers keep of the symbol table and the comments following
+ * the AIG, see 'aiger_set_read_mode'.
+ */
+enum aiger_read_mode
+{
+  aiger_read_all = 0,		/* symbols and comments (default) */
+  aiger_read_symbols = 1,	/* all symbols but no comments */
+  aiger_read_input_symbols = 2,	/* only the symbols of the inputs */
+  aiger_read_no_symbols = 3,	/* neither symbols nor comments */
+};
+
+typedef enum aiger_read_mode aiger_read_mode;
+
 /*------------------------------------------------------------------------*/
 
 struct aiger_and
@@ -178,6 +192,30 @@ aiger *aiger_init (void);
  */
 aiger *aiger_init_mem (void *mem_mgr, aiger_malloc, aiger_free);
 
+/*------------------------------------------------------------------------*/
+/* An arena hands out memory from large blocks by bumping a pointer and
+ * releases it all at once when it is deleted.  Freeing memory before that
+ * is a no-op, except for large allocations, which get a block of their own
+ * and are returned right away.  'aiger_arena_malloc' and 'aiger_arena_free'
+ * can be passed to 'aiger_init_mem' with the arena as memory manager, in
+ * order to share one arena between several AIGs.  It must not be used by
+ * several threads at the same time.
+ */
+typedef struct aiger_arena aiger_arena;
+
+aiger_arena *aiger_new_arena (void);
+void aiger_delete_arena (aiger_arena *);
+void *aiger_arena_malloc (void *arena, size_t bytes);
+void aiger_arena_free (void *arena, void *ptr, size_t bytes);
+
+/*------------------------------------------------------------------------*/
+/* Same as 'aiger_init' except that all memory of the AIG is taken from an
+ * arena of its own.  Then 'aiger_reset' simply deletes the arena instead
+ * of freeing every name and array separately.  This suits AIGs which are
+ * built or read once and then discarded as a whole.
+ */
+aiger *aiger_init_arena (void);
+
 /*------------------------------------------------------------------------*/
 /* Reset and delete the library.
  */
@@ -215,6 +253,27 @@ void aiger_add_reset (aiger *, unsigned lit, unsigned reset);
  */
 void aiger_add_and (aiger *, unsigned lhs, unsigned rhs0, unsigned rhs1);
 
+/*------------------------------------------------------------------------*/
+/* Make room for at least 'inputs' inputs, 'latches' latches and 'ands'
+ * ANDs in total and for variable indices up to 'maxvar', so that adding
+ * them afterwards does not reallocate.  Nothing is added and 'maxvar' of
+ * the AIG itself stays the same.
+ */
+void aiger_reserve (aiger *,
+		    unsigned inputs, unsigned latches, unsigned ands,
+		    unsigned maxvar);
+
+/*------------------------------------------------------------------------*/
+/* Add 'size' inputs, latches or ANDs at once, after reserving space for
+ * all of them.  Of the symbols, the inputs use 'lit' and 'name' and the
+ * latches in addition 'next' and 'reset', so the arrays of another AIG can
+ * be passed directly.  Otherwise this is the same as adding them one by
+ * one in the given order.
+ */
+void aiger_add_inputs (aiger *, unsigned size, const aiger_symbol *);
+void aiger_add_latches (aiger *, unsigned size, const aiger_symbol *);
+void aiger_add_ands (aiger *, unsigned size, const aiger_and *);
+
 /*------------------------------------------------------------------------*/
 /* Add a line of comments.  The comment may not contain a new line character.
  */
@@ -237,7 +296,9 @@ const char *aiger_check (aiger *);
  * standard library (see the 'aiger_put' definition above).  Note, that
  * writing in binary mode triggers 'aig_reencode' and thus destroys the
  * original literal association and may even delete AND nodes.  See
- * 'aiger_reencode' for more details.
+ * 'aiger_reencode' for more details.  Output is formatted into blocks,
+ * which are written with 'fwrite' (or passed to 'aiger_put' character by
+ * character) when full, so a failure may only be noticed at the end.
  */
 int aiger_write_to_file (aiger *, aiger_mode, FILE *);
 int aiger_write_to_string (aiger *, aiger_mode, char *str, size_t len);
@@ -246,10 +307,13 @@ int aiger_write_generic (aiger *, aiger_mode, void *state, aiger_put);
 /*------------------------------------------------------------------------*/
 /* The following function allows to write to a file.  The write mode is
  * determined from the suffix in the file name.  The mode used is ASCII for
- * a '.aag' suffix and binary mode otherwise.  In addition a '.gz' suffix can
- * be added which requests the file to written by piping it through 'gzip'.
- * This feature assumes that the 'gzip' program is in your path and can be
- * executed through 'popen'.  The return value is non zero on success.
+ * a '.aag' suffix and binary mode otherwise.  In addition a '.gz' or '.zst'
+ * suffix can be added which requests the file to be compressed.  If the
+ * library is compiled with 'AIGER_HAVE_ZLIB' respectively 'AIGER_HAVE_ZSTD'
+ * this is done in process with zlib respectively zstd.  Otherwise the file
+ * is piped through 'gzip' respectively 'zstd', which assumes that the
+ * program is in your path and can be executed through 'popen'.  The return
+ * value is non zero on success.
  */
 int aiger_open_and_write_to_file (aiger *, const char *file_name);
 
@@ -263,7 +327,11 @@ int aiger_open_and_write_to_file (aiger *, const char *file_name);
  * function nor in any cone of an output function are discarded.  The new
  * indices of ANDs start immediately after all input and latch indices.  The
  * data structures are updated accordingly including 'maxvar'.  The client
- * data within ANDs is reset to zero.
+ * data within ANDs is reset to zero.  Reencoding takes time linear in the
+ * size of the AIG.  Whether the AIG is reencoded is cached and maintained
+ * by the 'aiger_add_*' functions, so checking it again is cheap, as long
+ * as the client does not change the 'inputs', 'latches' or 'ands' arrays
+ * directly.
  */
 int aiger_is_reencoded (aiger *);
 void aiger_reencode (aiger *);
@@ -276,22 +344,48 @@ void aiger_reencode (aiger *);
  * returned is valid until the next call to this function and will be
  * deallocated on reset.
  *
- * TODO: this is just a stub and actually not really implemented yet.
+ * The coi is sequential: it starts from the outputs and the bad state,
+ * invariant constraint, justice and fairness literals and follows the
+ * inputs of ANDs as well as the next state functions of the latches it
+ * reaches, until nothing new is added.
  */
 const unsigned char * aiger_coi (aiger *);		/* [1..maxvar] */
 
 /*------------------------------------------------------------------------*/
-/* Read an AIG from a FILE, a string, or through a generic interface.  These
+/* Remove the latches and ANDs outside of the coi and reencode the AIG
+ * (see 'aiger_reencode'), which invalidates its literals.  All inputs are
+ * kept, so that the interface of the AIG does not change.
+ */
+void aiger_compact_coi (aiger *);
+
+/*------------------------------------------------------------------------*/
+/* Read an AIG from a FILE, a buffer, or through a generic interface.  These
  * functions return a non zero error message if an error occurred and
  * otherwise 0.  The paramater 'aiger_get' has the same return values as
  * 'getc', e.g. it returns 'EOF' when done.  After an error occurred the
  * library becomes invalid.  Only 'aiger_reset' or 'aiger_error' can be
  * used.  The latter returns the previously returned error message.
+ * Files and buffers are read in blocks, and the binary AND section is
+ * decoded directly from the block, so they are much faster to read than
+ * through 'aiger_get'.  A FILE is read until its end, unless the read mode
+ * skips the comments (see 'aiger_set_read_mode').  The buffer holds
+ * 'size' bytes, which may include zero bytes in binary mode.
  */
 const char *aiger_read_from_file (aiger *, FILE *);
+const char *aiger_read_from_buffer (aiger *, const char *bytes, size_t size);
 /*const char *aiger_read_from_string (aiger *, const char *str);*/
 const char *aiger_read_generic (aiger *, void *state, aiger_get);
 
+/*------------------------------------------------------------------------*/
+/* Restrict what the next read keeps after the AIG itself, e.g. tools which
+ * match inputs by name but do not care about the other names can use
+ * 'aiger_read_input_symbols'.  Names which are not kept are not copied,
+ * nor checked for duplicates, but their lines are still parsed.  Skipped
+ * comments are not read at all.  With 'aiger_read_no_symbols' reading
+ * stops right after the AIG, so the symbol table is not checked either.
+ */
+void aiger_set_read_mode (aiger *, aiger_read_mode);
+
 /*------------------------------------------------------------------------*/
 /* Returns a previously generated error message if the library is in an
  * invalid state.  After this function returns a non zero error message,
@@ -302,10 +396,37 @@ const char *aiger_read_generic (aiger *, void *state, aiger_get);
 const char *aiger_error (aiger *);
 
 /*------------------------------------------------------------------------*/
-/* Same semantics as with 'aiger_open_and_write_to_file' for reading.
+/* Same semantics as with 'aiger_open_and_write_to_file' for reading.  If
+ * a compressed file is read in process, it is decoded to the end even if
+ * reading stops early, and a corrupted or truncated file is reported as
+ * such ("can not decompress ...") instead of as a parse error.
  */
 const char *aiger_open_and_read_from_file (aiger *, const char *);
 
+/*------------------------------------------------------------------------*/
+/* Same as 'aiger_open_and_read_from_file' except that the file is mapped
+ * into memory and parsed in place.  If 'lazy' is non zero and the file is
+ * binary, the AND section is only located but not decoded: 'num_ands'
+ * stays zero (the header count is 'maxvar - num_inputs - num_latches') and
+ * the file stays mapped, until 'aiger_decode_ands' is called.  This is done
+ * implicitly by the functions which need the ANDs, e.g. checking, writing,
+ * reencoding or adding ANDs.  The AIG is only checked after decoding, and
+ * a corrupted AND section may first show up as an error in the symbol
+ * table, which is read right away.  If implicit decoding fails, these
+ * functions fail as well: 'aiger_coi' and 'aiger_is_and' return 0,
+ * 'aiger_is_reencoded' returns 0, and 'aiger_add_and', 'aiger_reencode'
+ * and 'aiger_compact_coi' do nothing, so clients should rather call
+ * 'aiger_decode_ands' first and check its result.
+ * Compressed and special files are read as usual.
+ */
+const char *aiger_open_and_map (aiger *, const char *, int lazy);
+
+/* Decode a pending AND section (see above).  Returns a non zero error
+ * message on failure or if the AIG is already in an error state, and
+ * otherwise 0, also if nothing was pending.
+ */
+const char *aiger_decode_ands (aiger *);
+
 /*------------------------------------------------------------------------*/
 /* Write symbol table or the comments to a file.  Result is zero on failure.
  */
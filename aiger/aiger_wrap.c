@@ -2636,17 +2636,19 @@ SWIGINTERN PyObject *SWIG_PyStaticMethod_New(PyObject *SWIGUNUSEDPARM(self), PyO
 #define SWIGTYPE_p_FILE swig_types[0]
 #define SWIGTYPE_p_aiger swig_types[1]
 #define SWIGTYPE_p_aiger_and swig_types[2]
-#define SWIGTYPE_p_aiger_symbol swig_types[3]
-#define SWIGTYPE_p_char swig_types[4]
-#define SWIGTYPE_p_f_char_p_void__int swig_types[5]
-#define SWIGTYPE_p_f_p_void__int swig_types[6]
-#define SWIGTYPE_p_f_p_void_p_void_size_t__void swig_types[7]
-#define SWIGTYPE_p_f_p_void_size_t__p_void swig_types[8]
-#define SWIGTYPE_p_p_char swig_types[9]
-#define SWIGTYPE_p_unsigned_char swig_types[10]
-#define SWIGTYPE_p_unsigned_int swig_types[11]
-static swig_type_info *swig_types[13];
-static swig_module_info swig_module = {swig_types, 12, 0, 0, 0, 0};
+#define SWIGTYPE_p_aiger_arena swig_types[3]
+#define SWIGTYPE_p_aiger_symbol swig_types[4]
+#define SWIGTYPE_p_char swig_types[5]
+#define SWIGTYPE_p_f_char_p_void__int swig_types[6]
+#define SWIGTYPE_p_f_p_void__int swig_types[7]
+#define SWIGTYPE_p_f_p_void_p_void_size_t__void swig_types[8]
+#define SWIGTYPE_p_f_p_void_size_t__p_void swig_types[9]
+#define SWIGTYPE_p_p_char swig_types[10]
+#define SWIGTYPE_p_unsigned_char swig_types[11]
+#define SWIGTYPE_p_unsigned_int swig_types[12]
+#define SWIGTYPE_p_void swig_types[13]
+static swig_type_info *swig_types[15];
+static swig_module_info swig_module = {swig_types, 14, 0, 0, 0, 0};
 #define SWIG_TypeQuery(name) SWIG_TypeQueryModule(&swig_module, &swig_module, name)
 #define SWIG_MangledTypeQuery(name) SWIG_MangledTypeQueryModule(&swig_module, &swig_module, name)
 
@@ -4759,6 +4761,110 @@ fail:
   return NULL;
 }
 
+SWIGINTERN PyObject *_wrap_aiger_new_arena(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger_arena *result = 0 ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_new_arena", 0, 0, 0)) SWIG_fail;
+  result = (aiger_arena *)aiger_new_arena();
+  resultobj = SWIG_NewPointerObj(SWIG_as_voidptr(result), SWIGTYPE_p_aiger_arena, 0 |  0 );
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_delete_arena(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger_arena *arg1 = (aiger_arena *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject *swig_obj[1] ;
+  
+  if (!args) SWIG_fail;
+  swig_obj[0] = args;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger_arena, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_delete_arena" "', argument " "1"" of type '" "aiger_arena *""'"); 
+  }
+  arg1 = (aiger_arena *)(argp1);
+  aiger_delete_arena(arg1);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_arena_malloc(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  void *arg1 = (void *) 0 ;
+  size_t arg2 ;
+  int res1 ;
+  size_t val2 ;
+  int ecode2 = 0 ;
+  PyObject *swig_obj[2] ;
+  void *result = 0 ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_arena_malloc", 2, 2, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0],SWIG_as_voidptrptr(&arg1), 0, 0);
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_arena_malloc" "', argument " "1"" of type '" "void *""'"); 
+  }
+  ecode2 = SWIG_AsVal_size_t(swig_obj[1], &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "aiger_arena_malloc" "', argument " "2"" of type '" "size_t""'");
+  } 
+  arg2 = (size_t)(val2);
+  result = (void *)aiger_arena_malloc(arg1,arg2);
+  resultobj = SWIG_NewPointerObj(SWIG_as_voidptr(result), SWIGTYPE_p_void, 0 |  0 );
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_arena_free(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  void *arg1 = (void *) 0 ;
+  void *arg2 = (void *) 0 ;
+  size_t arg3 ;
+  int res1 ;
+  int res2 ;
+  size_t val3 ;
+  int ecode3 = 0 ;
+  PyObject *swig_obj[3] ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_arena_free", 3, 3, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0],SWIG_as_voidptrptr(&arg1), 0, 0);
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_arena_free" "', argument " "1"" of type '" "void *""'"); 
+  }
+  res2 = SWIG_ConvertPtr(swig_obj[1],SWIG_as_voidptrptr(&arg2), 0, 0);
+  if (!SWIG_IsOK(res2)) {
+    SWIG_exception_fail(SWIG_ArgError(res2), "in method '" "aiger_arena_free" "', argument " "2"" of type '" "void *""'"); 
+  }
+  ecode3 = SWIG_AsVal_size_t(swig_obj[2], &val3);
+  if (!SWIG_IsOK(ecode3)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode3), "in method '" "aiger_arena_free" "', argument " "3"" of type '" "size_t""'");
+  } 
+  arg3 = (size_t)(val3);
+  aiger_arena_free(arg1,arg2,arg3);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_init_arena(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *result = 0 ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_init_arena", 0, 0, 0)) SWIG_fail;
+  result = (aiger *)aiger_init_arena();
+  resultobj = SWIG_NewPointerObj(SWIG_as_voidptr(result), SWIGTYPE_p_aiger, 0 |  0 );
+  return resultobj;
+fail:
+  return NULL;
+}
+
 
 SWIGINTERN PyObject *_wrap_aiger_reset(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
@@ -5159,6 +5265,166 @@ fail:
   return NULL;
 }
 
+SWIGINTERN PyObject *_wrap_aiger_reserve(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  unsigned int arg2 ;
+  unsigned int arg3 ;
+  unsigned int arg4 ;
+  unsigned int arg5 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  unsigned int val2 ;
+  int ecode2 = 0 ;
+  unsigned int val3 ;
+  int ecode3 = 0 ;
+  unsigned int val4 ;
+  int ecode4 = 0 ;
+  unsigned int val5 ;
+  int ecode5 = 0 ;
+  PyObject *swig_obj[5] ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_reserve", 5, 5, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_reserve" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  ecode2 = SWIG_AsVal_unsigned_SS_int(swig_obj[1], &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "aiger_reserve" "', argument " "2"" of type '" "unsigned int""'");
+  } 
+  arg2 = (unsigned int)(val2);
+  ecode3 = SWIG_AsVal_unsigned_SS_int(swig_obj[2], &val3);
+  if (!SWIG_IsOK(ecode3)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode3), "in method '" "aiger_reserve" "', argument " "3"" of type '" "unsigned int""'");
+  } 
+  arg3 = (unsigned int)(val3);
+  ecode4 = SWIG_AsVal_unsigned_SS_int(swig_obj[3], &val4);
+  if (!SWIG_IsOK(ecode4)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode4), "in method '" "aiger_reserve" "', argument " "4"" of type '" "unsigned int""'");
+  } 
+  arg4 = (unsigned int)(val4);
+  ecode5 = SWIG_AsVal_unsigned_SS_int(swig_obj[4], &val5);
+  if (!SWIG_IsOK(ecode5)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode5), "in method '" "aiger_reserve" "', argument " "5"" of type '" "unsigned int""'");
+  } 
+  arg5 = (unsigned int)(val5);
+  aiger_reserve(arg1,arg2,arg3,arg4,arg5);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_add_inputs(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  unsigned int arg2 ;
+  aiger_symbol *arg3 = (aiger_symbol *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  unsigned int val2 ;
+  int ecode2 = 0 ;
+  void *argp3 = 0 ;
+  int res3 = 0 ;
+  PyObject *swig_obj[3] ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_add_inputs", 3, 3, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_add_inputs" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  ecode2 = SWIG_AsVal_unsigned_SS_int(swig_obj[1], &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "aiger_add_inputs" "', argument " "2"" of type '" "unsigned int""'");
+  } 
+  arg2 = (unsigned int)(val2);
+  res3 = SWIG_ConvertPtr(swig_obj[2], &argp3,SWIGTYPE_p_aiger_symbol, 0 |  0 );
+  if (!SWIG_IsOK(res3)) {
+    SWIG_exception_fail(SWIG_ArgError(res3), "in method '" "aiger_add_inputs" "', argument " "3"" of type '" "aiger_symbol const *""'"); 
+  }
+  arg3 = (aiger_symbol *)(argp3);
+  aiger_add_inputs(arg1,arg2,(aiger_symbol const *)arg3);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_add_latches(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  unsigned int arg2 ;
+  aiger_symbol *arg3 = (aiger_symbol *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  unsigned int val2 ;
+  int ecode2 = 0 ;
+  void *argp3 = 0 ;
+  int res3 = 0 ;
+  PyObject *swig_obj[3] ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_add_latches", 3, 3, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_add_latches" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  ecode2 = SWIG_AsVal_unsigned_SS_int(swig_obj[1], &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "aiger_add_latches" "', argument " "2"" of type '" "unsigned int""'");
+  } 
+  arg2 = (unsigned int)(val2);
+  res3 = SWIG_ConvertPtr(swig_obj[2], &argp3,SWIGTYPE_p_aiger_symbol, 0 |  0 );
+  if (!SWIG_IsOK(res3)) {
+    SWIG_exception_fail(SWIG_ArgError(res3), "in method '" "aiger_add_latches" "', argument " "3"" of type '" "aiger_symbol const *""'"); 
+  }
+  arg3 = (aiger_symbol *)(argp3);
+  aiger_add_latches(arg1,arg2,(aiger_symbol const *)arg3);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_add_ands(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  unsigned int arg2 ;
+  aiger_and *arg3 = (aiger_and *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  unsigned int val2 ;
+  int ecode2 = 0 ;
+  void *argp3 = 0 ;
+  int res3 = 0 ;
+  PyObject *swig_obj[3] ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_add_ands", 3, 3, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_add_ands" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  ecode2 = SWIG_AsVal_unsigned_SS_int(swig_obj[1], &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "aiger_add_ands" "', argument " "2"" of type '" "unsigned int""'");
+  } 
+  arg2 = (unsigned int)(val2);
+  res3 = SWIG_ConvertPtr(swig_obj[2], &argp3,SWIGTYPE_p_aiger_and, 0 |  0 );
+  if (!SWIG_IsOK(res3)) {
+    SWIG_exception_fail(SWIG_ArgError(res3), "in method '" "aiger_add_ands" "', argument " "3"" of type '" "aiger_and const *""'"); 
+  }
+  arg3 = (aiger_and *)(argp3);
+  aiger_add_ands(arg1,arg2,(aiger_and const *)arg3);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
 
 SWIGINTERN PyObject *_wrap_aiger_add_comment(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
@@ -5445,6 +5711,27 @@ fail:
   return NULL;
 }
 
+SWIGINTERN PyObject *_wrap_aiger_compact_coi(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject *swig_obj[1] ;
+  
+  if (!args) SWIG_fail;
+  swig_obj[0] = args;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_compact_coi" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  aiger_compact_coi(arg1);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
 
 SWIGINTERN PyObject *_wrap_aiger_read_from_file(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
@@ -5475,6 +5762,46 @@ fail:
   return NULL;
 }
 
+SWIGINTERN PyObject *_wrap_aiger_read_from_buffer(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  char *arg2 = (char *) 0 ;
+  size_t arg3 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int res2 ;
+  char *buf2 = 0 ;
+  int alloc2 = 0 ;
+  size_t val3 ;
+  int ecode3 = 0 ;
+  PyObject *swig_obj[3] ;
+  char *result = 0 ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_read_from_buffer", 3, 3, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_read_from_buffer" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  res2 = SWIG_AsCharPtrAndSize(swig_obj[1], &buf2, NULL, &alloc2);
+  if (!SWIG_IsOK(res2)) {
+    SWIG_exception_fail(SWIG_ArgError(res2), "in method '" "aiger_read_from_buffer" "', argument " "2"" of type '" "char const *""'");
+  }
+  arg2 = (char *)(buf2);
+  ecode3 = SWIG_AsVal_size_t(swig_obj[2], &val3);
+  if (!SWIG_IsOK(ecode3)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode3), "in method '" "aiger_read_from_buffer" "', argument " "3"" of type '" "size_t""'");
+  } 
+  arg3 = (size_t)(val3);
+  result = (char *)aiger_read_from_buffer(arg1,(char const *)arg2,arg3);
+  resultobj = SWIG_FromCharPtr((const char *)result);
+  if (alloc2 == SWIG_NEWOBJ) free((char*)buf2);
+  return resultobj;
+fail:
+  if (alloc2 == SWIG_NEWOBJ) free((char*)buf2);
+  return NULL;
+}
+
 
 SWIGINTERN PyObject *_wrap_aiger_read_generic(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
@@ -5510,6 +5837,34 @@ fail:
   return NULL;
 }
 
+SWIGINTERN PyObject *_wrap_aiger_set_read_mode(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  aiger_read_mode arg2 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int val2 ;
+  int ecode2 = 0 ;
+  PyObject *swig_obj[2] ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_set_read_mode", 2, 2, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_set_read_mode" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  ecode2 = SWIG_AsVal_int(swig_obj[1], &val2);
+  if (!SWIG_IsOK(ecode2)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode2), "in method '" "aiger_set_read_mode" "', argument " "2"" of type '" "aiger_read_mode""'");
+  } 
+  arg2 = (aiger_read_mode)(val2);
+  aiger_set_read_mode(arg1,arg2);
+  resultobj = SWIG_Py_Void();
+  return resultobj;
+fail:
+  return NULL;
+}
+
 
 SWIGINTERN PyObject *_wrap_aiger_error(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
@@ -5566,6 +5921,68 @@ fail:
   return NULL;
 }
 
+SWIGINTERN PyObject *_wrap_aiger_open_and_map(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  char *arg2 = (char *) 0 ;
+  int arg3 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  int res2 ;
+  char *buf2 = 0 ;
+  int alloc2 = 0 ;
+  int val3 ;
+  int ecode3 = 0 ;
+  PyObject *swig_obj[3] ;
+  char *result = 0 ;
+  
+  if (!SWIG_Python_UnpackTuple(args, "aiger_open_and_map", 3, 3, swig_obj)) SWIG_fail;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_open_and_map" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  res2 = SWIG_AsCharPtrAndSize(swig_obj[1], &buf2, NULL, &alloc2);
+  if (!SWIG_IsOK(res2)) {
+    SWIG_exception_fail(SWIG_ArgError(res2), "in method '" "aiger_open_and_map" "', argument " "2"" of type '" "char const *""'");
+  }
+  arg2 = (char *)(buf2);
+  ecode3 = SWIG_AsVal_int(swig_obj[2], &val3);
+  if (!SWIG_IsOK(ecode3)) {
+    SWIG_exception_fail(SWIG_ArgError(ecode3), "in method '" "aiger_open_and_map" "', argument " "3"" of type '" "int""'");
+  } 
+  arg3 = (int)(val3);
+  result = (char *)aiger_open_and_map(arg1,(char const *)arg2,arg3);
+  resultobj = SWIG_FromCharPtr((const char *)result);
+  if (alloc2 == SWIG_NEWOBJ) free((char*)buf2);
+  return resultobj;
+fail:
+  if (alloc2 == SWIG_NEWOBJ) free((char*)buf2);
+  return NULL;
+}
+
+SWIGINTERN PyObject *_wrap_aiger_decode_ands(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
+  PyObject *resultobj = 0;
+  aiger *arg1 = (aiger *) 0 ;
+  void *argp1 = 0 ;
+  int res1 = 0 ;
+  PyObject *swig_obj[1] ;
+  char *result = 0 ;
+  
+  if (!args) SWIG_fail;
+  swig_obj[0] = args;
+  res1 = SWIG_ConvertPtr(swig_obj[0], &argp1,SWIGTYPE_p_aiger, 0 |  0 );
+  if (!SWIG_IsOK(res1)) {
+    SWIG_exception_fail(SWIG_ArgError(res1), "in method '" "aiger_decode_ands" "', argument " "1"" of type '" "aiger *""'"); 
+  }
+  arg1 = (aiger *)(argp1);
+  result = (char *)aiger_decode_ands(arg1);
+  resultobj = SWIG_FromCharPtr((const char *)result);
+  return resultobj;
+fail:
+  return NULL;
+}
+
 
 SWIGINTERN PyObject *_wrap_aiger_write_symbols_to_file(PyObject *SWIGUNUSEDPARM(self), PyObject *args) {
   PyObject *resultobj = 0;
@@ -5902,6 +6319,11 @@ static PyMethodDef SwigMethods[] = {
 	 { "aiger_version", _wrap_aiger_version, METH_NOARGS, NULL},
 	 { "aiger_init", _wrap_aiger_init, METH_NOARGS, NULL},
 	 { "aiger_init_mem", _wrap_aiger_init_mem, METH_VARARGS, NULL},
+	 { "aiger_new_arena", _wrap_aiger_new_arena, METH_NOARGS, NULL},
+	 { "aiger_delete_arena", _wrap_aiger_delete_arena, METH_O, NULL},
+	 { "aiger_arena_malloc", _wrap_aiger_arena_malloc, METH_VARARGS, NULL},
+	 { "aiger_arena_free", _wrap_aiger_arena_free, METH_VARARGS, NULL},
+	 { "aiger_init_arena", _wrap_aiger_init_arena, METH_NOARGS, NULL},
 	 { "aiger_reset", _wrap_aiger_reset, METH_O, NULL},
 	 { "aiger_add_input", _wrap_aiger_add_input, METH_VARARGS, NULL},
 	 { "aiger_add_latch", _wrap_aiger_add_latch, METH_VARARGS, NULL},
@@ -5912,6 +6334,10 @@ static PyMethodDef SwigMethods[] = {
 	 { "aiger_add_fairness", _wrap_aiger_add_fairness, METH_VARARGS, NULL},
 	 { "aiger_add_reset", _wrap_aiger_add_reset, METH_VARARGS, NULL},
 	 { "aiger_add_and", _wrap_aiger_add_and, METH_VARARGS, NULL},
+	 { "aiger_reserve", _wrap_aiger_reserve, METH_VARARGS, NULL},
+	 { "aiger_add_inputs", _wrap_aiger_add_inputs, METH_VARARGS, NULL},
+	 { "aiger_add_latches", _wrap_aiger_add_latches, METH_VARARGS, NULL},
+	 { "aiger_add_ands", _wrap_aiger_add_ands, METH_VARARGS, NULL},
 	 { "aiger_add_comment", _wrap_aiger_add_comment, METH_VARARGS, NULL},
 	 { "aiger_check", _wrap_aiger_check, METH_O, NULL},
 	 { "aiger_write_to_file", _wrap_aiger_write_to_file, METH_VARARGS, NULL},
@@ -5921,10 +6347,15 @@ static PyMethodDef SwigMethods[] = {
 	 { "aiger_is_reencoded", _wrap_aiger_is_reencoded, METH_O, NULL},
 	 { "aiger_reencode", _wrap_aiger_reencode, METH_O, NULL},
 	 { "aiger_coi", _wrap_aiger_coi, METH_O, NULL},
+	 { "aiger_compact_coi", _wrap_aiger_compact_coi, METH_O, NULL},
 	 { "aiger_read_from_file", _wrap_aiger_read_from_file, METH_VARARGS, NULL},
+	 { "aiger_read_from_buffer", _wrap_aiger_read_from_buffer, METH_VARARGS, NULL},
 	 { "aiger_read_generic", _wrap_aiger_read_generic, METH_VARARGS, NULL},
+	 { "aiger_set_read_mode", _wrap_aiger_set_read_mode, METH_VARARGS, NULL},
 	 { "aiger_error", _wrap_aiger_error, METH_O, NULL},
 	 { "aiger_open_and_read_from_file", _wrap_aiger_open_and_read_from_file, METH_VARARGS, NULL},
+	 { "aiger_open_and_map", _wrap_aiger_open_and_map, METH_VARARGS, NULL},
+	 { "aiger_decode_ands", _wrap_aiger_decode_ands, METH_O, NULL},
 	 { "aiger_write_symbols_to_file", _wrap_aiger_write_symbols_to_file, METH_VARARGS, NULL},
 	 { "aiger_write_comments_to_file", _wrap_aiger_write_comments_to_file, METH_VARARGS, NULL},
 	 { "aiger_strip_symbols_and_comments", _wrap_aiger_strip_symbols_and_comments, METH_O, NULL},
@@ -5947,6 +6378,7 @@ static PyMethodDef SwigMethods_proxydocs[] = {
 static swig_type_info _swigt__p_FILE = {"_p_FILE", "FILE *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_aiger = {"_p_aiger", "struct aiger *|aiger *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_aiger_and = {"_p_aiger_and", "struct aiger_and *|aiger_and *", 0, 0, (void*)0, 0};
+static swig_type_info _swigt__p_aiger_arena = {"_p_aiger_arena", "struct aiger_arena *|aiger_arena *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_aiger_symbol = {"_p_aiger_symbol", "struct aiger_symbol *|aiger_symbol *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_char = {"_p_char", "char *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_f_char_p_void__int = {"_p_f_char_p_void__int", "aiger_put|int (*)(char,void *)", 0, 0, (void*)0, 0};
@@ -5956,11 +6388,13 @@ static swig_type_info _swigt__p_f_p_void_size_t__p_void = {"_p_f_p_void_size_t__
 static swig_type_info _swigt__p_p_char = {"_p_p_char", "char **", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_unsigned_char = {"_p_unsigned_char", "unsigned char *", 0, 0, (void*)0, 0};
 static swig_type_info _swigt__p_unsigned_int = {"_p_unsigned_int", "unsigned int *", 0, 0, (void*)0, 0};
+static swig_type_info _swigt__p_void = {"_p_void", "void *", 0, 0, (void*)0, 0};
 
 static swig_type_info *swig_type_initial[] = {
   &_swigt__p_FILE,
   &_swigt__p_aiger,
   &_swigt__p_aiger_and,
+  &_swigt__p_aiger_arena,
   &_swigt__p_aiger_symbol,
   &_swigt__p_char,
   &_swigt__p_f_char_p_void__int,
@@ -5970,11 +6404,13 @@ static swig_type_info *swig_type_initial[] = {
   &_swigt__p_p_char,
   &_swigt__p_unsigned_char,
   &_swigt__p_unsigned_int,
+  &_swigt__p_void,
 };
 
 static swig_cast_info _swigc__p_FILE[] = {  {&_swigt__p_FILE, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_aiger[] = {  {&_swigt__p_aiger, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_aiger_and[] = {  {&_swigt__p_aiger_and, 0, 0, 0},{0, 0, 0, 0}};
+static swig_cast_info _swigc__p_aiger_arena[] = {  {&_swigt__p_aiger_arena, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_aiger_symbol[] = {  {&_swigt__p_aiger_symbol, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_char[] = {  {&_swigt__p_char, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_f_char_p_void__int[] = {  {&_swigt__p_f_char_p_void__int, 0, 0, 0},{0, 0, 0, 0}};
@@ -5984,11 +6420,13 @@ static swig_cast_info _swigc__p_f_p_void_size_t__p_void[] = {  {&_swigt__p_f_p_v
 static swig_cast_info _swigc__p_p_char[] = {  {&_swigt__p_p_char, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_unsigned_char[] = {  {&_swigt__p_unsigned_char, 0, 0, 0},{0, 0, 0, 0}};
 static swig_cast_info _swigc__p_unsigned_int[] = {  {&_swigt__p_unsigned_int, 0, 0, 0},{0, 0, 0, 0}};
+static swig_cast_info _swigc__p_void[] = {  {&_swigt__p_void, 0, 0, 0},{0, 0, 0, 0}};
 
 static swig_cast_info *swig_cast_initial[] = {
   _swigc__p_FILE,
   _swigc__p_aiger,
   _swigc__p_aiger_and,
+  _swigc__p_aiger_arena,
   _swigc__p_aiger_symbol,
   _swigc__p_char,
   _swigc__p_f_char_p_void__int,
@@ -5998,6 +6436,7 @@ static swig_cast_info *swig_cast_initial[] = {
   _swigc__p_p_char,
   _swigc__p_unsigned_char,
   _swigc__p_unsigned_int,
+  _swigc__p_void,
 };
 
 
@@ -6733,6 +7172,10 @@ SWIG_init(void) {
   SWIG_Python_SetConstant(d, "aiger_binary_mode",SWIG_From_int((int)(aiger_binary_mode)));
   SWIG_Python_SetConstant(d, "aiger_ascii_mode",SWIG_From_int((int)(aiger_ascii_mode)));
   SWIG_Python_SetConstant(d, "aiger_stripped_mode",SWIG_From_int((int)(aiger_stripped_mode)));
+  SWIG_Python_SetConstant(d, "aiger_read_all",SWIG_From_int((int)(aiger_read_all)));
+  SWIG_Python_SetConstant(d, "aiger_read_symbols",SWIG_From_int((int)(aiger_read_symbols)));
+  SWIG_Python_SetConstant(d, "aiger_read_input_symbols",SWIG_From_int((int)(aiger_read_input_symbols)));
+  SWIG_Python_SetConstant(d, "aiger_read_no_symbols",SWIG_From_int((int)(aiger_read_no_symbols)));
 #if PY_VERSION_HEX >= 0x03000000
   return m;
 #else
@@ -67,6 +67,10 @@ aiger_true = _aiger_wrap.aiger_true
 aiger_binary_mode = _aiger_wrap.aiger_binary_mode
 aiger_ascii_mode = _aiger_wrap.aiger_ascii_mode
 aiger_stripped_mode = _aiger_wrap.aiger_stripped_mode
+aiger_read_all = _aiger_wrap.aiger_read_all
+aiger_read_symbols = _aiger_wrap.aiger_read_symbols
+aiger_read_input_symbols = _aiger_wrap.aiger_read_input_symbols
+aiger_read_no_symbols = _aiger_wrap.aiger_read_no_symbols
 class aiger_and(object):
     thisown = property(lambda x: x.this.own(), lambda x, v: x.this.own(v), doc="The membership flag")
     __repr__ = _swig_repr
@@ -140,6 +144,21 @@ def aiger_init():
 def aiger_init_mem(mem_mgr, arg2, arg3):
     return _aiger_wrap.aiger_init_mem(mem_mgr, arg2, arg3)
 
+def aiger_new_arena():
+    return _aiger_wrap.aiger_new_arena()
+
+def aiger_delete_arena(arg1):
+    return _aiger_wrap.aiger_delete_arena(arg1)
+
+def aiger_arena_malloc(arena, bytes):
+    return _aiger_wrap.aiger_arena_malloc(arena, bytes)
+
+def aiger_arena_free(arena, ptr, bytes):
+    return _aiger_wrap.aiger_arena_free(arena, ptr, bytes)
+
+def aiger_init_arena():
+    return _aiger_wrap.aiger_init_arena()
+
 def aiger_reset(arg1):
     return _aiger_wrap.aiger_reset(arg1)
 
@@ -170,6 +189,18 @@ def aiger_add_reset(arg1, lit, reset):
 def aiger_add_and(arg1, lhs, rhs0, rhs1):
     return _aiger_wrap.aiger_add_and(arg1, lhs, rhs0, rhs1)
 
+def aiger_reserve(arg1, inputs, latches, ands, maxvar):
+    return _aiger_wrap.aiger_reserve(arg1, inputs, latches, ands, maxvar)
+
+def aiger_add_inputs(arg1, size, arg3):
+    return _aiger_wrap.aiger_add_inputs(arg1, size, arg3)
+
+def aiger_add_latches(arg1, size, arg3):
+    return _aiger_wrap.aiger_add_latches(arg1, size, arg3)
+
+def aiger_add_ands(arg1, size, arg3):
+    return _aiger_wrap.aiger_add_ands(arg1, size, arg3)
+
 def aiger_add_comment(arg1, comment_line):
     return _aiger_wrap.aiger_add_comment(arg1, comment_line)
 
@@ -197,18 +228,33 @@ def aiger_reencode(arg1):
 def aiger_coi(arg1):
     return _aiger_wrap.aiger_coi(arg1)
 
+def aiger_compact_coi(arg1):
+    return _aiger_wrap.aiger_compact_coi(arg1)
+
 def aiger_read_from_file(arg1, arg2):
     return _aiger_wrap.aiger_read_from_file(arg1, arg2)
 
+def aiger_read_from_buffer(arg1, bytes, size):
+    return _aiger_wrap.aiger_read_from_buffer(arg1, bytes, size)
+
 def aiger_read_generic(arg1, state, arg3):
     return _aiger_wrap.aiger_read_generic(arg1, state, arg3)
 
+def aiger_set_read_mode(arg1, arg2):
+    return _aiger_wrap.aiger_set_read_mode(arg1, arg2)
+
 def aiger_error(arg1):
     return _aiger_wrap.aiger_error(arg1)
 
 def aiger_open_and_read_from_file(arg1, arg2):
     return _aiger_wrap.aiger_open_and_read_from_file(arg1, arg2)
 
+def aiger_open_and_map(arg1, arg2, lazy):
+    return _aiger_wrap.aiger_open_and_map(arg1, arg2, lazy)
+
+def aiger_decode_ands(arg1):
+    return _aiger_wrap.aiger_decode_ands(arg1)
+
 def aiger_write_symbols_to_file(arg1, file):
     return _aiger_wrap.aiger_write_symbols_to_file(arg1, file)
 
@@ -20,21 +20,968 @@
  *************************************************************************/
 
 #include <assert.h>
+#include <errno.h>
+#include <getopt.h>
 #include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "aiger/aiger.h"
+#include "aigcnf.h"
 
 static void printHelp() {
 #ifdef GITVER
     fprintf(stderr, "aigprod version: %s\n", GITVER);
 #endif
-    fprintf(stderr, "Usage: aigprod INPUTFILES...\n");
-    fprintf(stderr, "Create the product of AIGs with common inputs.\n");
+    fprintf(stderr, "Usage: aigprod [OPTIONS]... INPUTFILES...\n");
+    fprintf(stderr, "An input file @FILE adds the files listed in FILE, one "
+                    "per line\n(@- reads the list from the standard "
+                    "input).\n");
+    fprintf(stderr, "Create the product of AIGs, matching their inputs by "
+                    "name.\n");
+    fprintf(stderr, "  -h    print this message\n");
+    fprintf(stderr, "  -j    number of threads parsing the input files "
+                    "(default: all cores)\n");
+    fprintf(stderr, "  -k    unrolling bound for --cnf\n");
+    fprintf(stderr, "  --append\n"
+                    "        extend the product in the first input file "
+                    "with the others,\n"
+                    "        without re-merging its components\n");
+    fprintf(stderr, "  --concat[=FILE]\n"
+                    "        also read AIGs concatenated in FILE (default: "
+                    "the standard\n"
+                    "        input), each preceded by a line with its length "
+                    "in bytes\n");
+    fprintf(stderr, "  --stream\n"
+                    "        stream the plain product (no structural "
+                    "hashing) to the\n"
+                    "        output, reading only one component ahead of the "
+                    "one\n"
+                    "        being streamed; all components must then have "
+                    "the same\n"
+                    "        input names in the same order, and nothing is "
+                    "written\n"
+                    "        if one cannot be read\n");
+    fprintf(stderr, "  --map FILE\n"
+                    "        write, for each component, its sizes and "
+                    "timings and where\n"
+                    "        its latches, gates and output are in the "
+                    "product to FILE\n");
+    fprintf(stderr, "  --merge-latches\n"
+                    "        merge latches that always hold the same value, "
+                    "e.g. the\n"
+                    "        tick_tock clocks of all components\n");
+    fprintf(stderr, "  --tree\n"
+                    "        multiply the inputs pairwise in a balanced tree, "
+                    "in parallel,\n"
+                    "        reducing each partial product to its cone of "
+                    "influence\n"
+                    "        (and merging its latches with "
+                    "--merge-latches)\n");
+    fprintf(stderr, "  --cnf write a DIMACS CNF, satisfiable iff the output "
+                    "can be true\n"
+                    "        within k steps, instead of the AIG\n");
     return;
 }
 
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* A hash table of all and gates in the product, used for structural
+ * hashing: the key is the pair of (already remapped) fanin literals with
+ * the larger one first, and an entry with lhs == 0 is empty
+ */
+typedef struct {
+    unsigned lhs;
+    unsigned rhs0;
+    unsigned rhs1;
+} Gate;
+
+typedef struct {
+    Gate* gates;
+    unsigned capacity;  // always a power of 2
+    unsigned noGates;
+} GateTable;
+
+static inline unsigned hashGate(unsigned rhs0, unsigned rhs1) {
+    return (rhs0 * 2654435761u) ^ (rhs1 * 40503u);
+}
+
+static void growTable(GateTable* table) {
+    Gate* old = table->gates;
+    unsigned oldCapacity = table->capacity;
+    table->capacity = oldCapacity ? 2 * oldCapacity : 1024;
+    table->gates = calloc(table->capacity, sizeof(Gate));
+    for (unsigned i = 0; i < oldCapacity; i++) {
+        if (old[i].lhs == 0)
+            continue;
+        unsigned h = hashGate(old[i].rhs0, old[i].rhs1);
+        h &= table->capacity - 1;
+        while (table->gates[h].lhs != 0)
+            h = (h + 1) & (table->capacity - 1);
+        table->gates[h] = old[i];
+    }
+    free(old);
+}
+
+/* Return a literal for the conjunction of rhs0 and rhs1 in dst, reusing
+ * an existing gate with the same fanins if there is one
+ */
+static unsigned and(aiger* dst, GateTable* table,
+                    unsigned rhs0, unsigned rhs1) {
+    // constant propagation and trivial cases first
+    if (rhs0 == aiger_false || rhs1 == aiger_false
+            || rhs0 == aiger_not(rhs1))
+        return aiger_false;
+    if (rhs0 == aiger_true || rhs0 == rhs1)
+        return rhs1;
+    if (rhs1 == aiger_true)
+        return rhs0;
+    if (rhs0 < rhs1) {
+        unsigned temp = rhs0;
+        rhs0 = rhs1;
+        rhs1 = temp;
+    }
+    // then we look for a structurally equal gate
+    if (2 * (table->noGates + 1) > table->capacity)
+        growTable(table);
+    unsigned h = hashGate(rhs0, rhs1) & (table->capacity - 1);
+    while (table->gates[h].lhs != 0) {
+        Gate* g = table->gates + h;
+        if (g->rhs0 == rhs0 && g->rhs1 == rhs1)
+            return g->lhs;
+        h = (h + 1) & (table->capacity - 1);
+    }
+    // none found, we need a fresh one
+    unsigned lhs = dst->maxvar * 2 + 2;
+    aiger_add_and(dst, lhs, rhs0, rhs1);
+    table->gates[h].lhs = lhs;
+    table->gates[h].rhs0 = rhs0;
+    table->gates[h].rhs1 = rhs1;
+    table->noGates++;
+    return lhs;
+}
+
+/* Add the gates already in aig to the table, so that an AIG read from a
+ * file can be extended with structural hashing (see --append)
+ */
+static void hashGates(GateTable* table, aiger* aig) {
+    for (unsigned i = 0; i < aig->num_ands; i++) {
+        unsigned rhs0 = aig->ands[i].rhs0;
+        unsigned rhs1 = aig->ands[i].rhs1;
+        if (rhs0 < rhs1) {
+            unsigned temp = rhs0;
+            rhs0 = rhs1;
+            rhs1 = temp;
+        }
+        if (2 * (table->noGates + 1) > table->capacity)
+            growTable(table);
+        unsigned h = hashGate(rhs0, rhs1) & (table->capacity - 1);
+        while (table->gates[h].lhs != 0 && (table->gates[h].rhs0 != rhs0
+                                            || table->gates[h].rhs1 != rhs1))
+            h = (h + 1) & (table->capacity - 1);
+        if (table->gates[h].lhs != 0)
+            continue;  // a duplicate, we keep the first one
+        table->gates[h].lhs = aig->ands[i].lhs;
+        table->gates[h].rhs0 = rhs0;
+        table->gates[h].rhs1 = rhs1;
+        table->noGates++;
+    }
+}
+
+/* A hash table from input names to the input literals of the product,
+ * so that components are matched by input name and the inputs of the
+ * product are the union of those of the components
+ * Unnamed inputs are named after their position, as in the symbol table:
+ * i0, i1, ... An entry with key == NULL is empty.
+ */
+typedef struct {
+    char** keys;
+    unsigned* lits;
+    unsigned capacity;  // always a power of 2
+    unsigned size;
+} InputIndex;
+
+static inline unsigned hashName(const char* name) {
+    // FNV-1a
+    unsigned h = 2166136261u;
+    for (; *name; name++)
+        h = (h ^ (unsigned char) *name) * 16777619u;
+    return h;
+}
+
+static unsigned findSlot(InputIndex* index, const char* name) {
+    unsigned h = hashName(name) & (index->capacity - 1);
+    while (index->keys[h] != NULL && strcmp(index->keys[h], name) != 0)
+        h = (h + 1) & (index->capacity - 1);
+    return h;
+}
+
+static void growIndex(InputIndex* index) {
+    char** oldKeys = index->keys;
+    unsigned* oldLits = index->lits;
+    unsigned oldCapacity = index->capacity;
+    index->capacity = oldCapacity ? 2 * oldCapacity : 64;
+    index->keys = calloc(index->capacity, sizeof(char*));
+    index->lits = malloc(index->capacity * sizeof(unsigned));
+    for (unsigned i = 0; i < oldCapacity; i++) {
+        if (oldKeys[i] == NULL)
+            continue;
+        unsigned h = findSlot(index, oldKeys[i]);
+        index->keys[h] = oldKeys[i];
+        index->lits[h] = oldLits[i];
+    }
+    free(oldKeys);
+    free(oldLits);
+}
+
+static void deleteIndex(InputIndex* index) {
+    for (unsigned i = 0; i < index->capacity; i++)
+        free(index->keys[i]);
+    free(index->keys);
+    free(index->lits);
+}
+
+/* Return the name of the i-th input of aig, buffer holds the one of an
+ * unnamed input
+ */
+static const char* inputName(aiger* aig, unsigned i, char* buffer) {
+    if (aig->inputs[i].name != NULL)
+        return aig->inputs[i].name;
+    sprintf(buffer, "i%u", i);
+    return buffer;
+}
+
+/* Return the slot of the i-th input of aig, keyed by its name
+ */
+static unsigned inputSlot(InputIndex* index, aiger* aig, unsigned i) {
+    char buffer[32];
+    const char* name = inputName(aig, i, buffer);
+    if (2 * (index->size + 1) > index->capacity)
+        growIndex(index);
+    unsigned h = findSlot(index, name);
+    if (index->keys[h] == NULL) {
+        index->keys[h] = strdup(name);
+        index->lits[h] = 0;
+        index->size++;
+    }
+    return h;
+}
+
+/* Add the inputs already in aig to the index (see --append)
+ */
+static void indexInputs(InputIndex* index, aiger* aig) {
+    for (unsigned i = 0; i < aig->num_inputs; i++) {
+        unsigned h = inputSlot(index, aig, i);
+        if (index->lits[h] == 0)
+            index->lits[h] = aig->inputs[i].lit;
+    }
+}
+
+/* Return the literal of the product input with the same name as the i-th
+ * input of src, adding it to dst if there is none yet
+ */
+static unsigned matchInput(aiger* dst, InputIndex* index,
+                           aiger* src, unsigned i) {
+    unsigned h = inputSlot(index, src, i);
+    if (index->lits[h] == 0) {
+        index->lits[h] = dst->maxvar * 2 + 2;
+        aiger_add_input(dst, index->lits[h], src->inputs[i].name);
+    }
+    return index->lits[h];
+}
+
+static inline unsigned mapLit(unsigned* map, unsigned lit) {
+    return map[aiger_lit2var(lit)] ^ aiger_sign(lit);
+}
+
+/* Copy src into dst: inputs are identified by their names, latches get
+ * fresh variables, and all gates go through the structural hash table so
+ * that logic already present in dst is reused
+ * NOTE: src is reencoded and the dst literal of its output is returned
+ */
+static unsigned mergeComponent(aiger* dst, GateTable* table,
+                               InputIndex* index, aiger* src) {
+    // reencoding gives us the and gates in topological order
+    aiger_reencode(src);
+    unsigned* map = malloc((src->maxvar + 1) * sizeof(unsigned));
+    map[0] = aiger_false;
+    for (unsigned i = 0; i < src->num_inputs; i++)
+        map[aiger_lit2var(src->inputs[i].lit)] = matchInput(dst, index,
+                                                            src, i);
+    // the next-state functions are only known after the gates are in
+    unsigned firstLatch = dst->num_latches;
+    for (unsigned i = 0; i < src->num_latches; i++) {
+        aiger_symbol* latch = src->latches + i;
+        unsigned lit = dst->maxvar * 2 + 2;
+        aiger_add_latch(dst, lit, aiger_false, latch->name);
+        aiger_add_reset(dst, lit,
+                        latch->reset == latch->lit ? lit : latch->reset);
+        map[aiger_lit2var(latch->lit)] = lit;
+    }
+    for (unsigned i = 0; i < src->num_ands; i++) {
+        aiger_and* gate = src->ands + i;
+        map[aiger_lit2var(gate->lhs)] = and(dst, table,
+                                            mapLit(map, gate->rhs0),
+                                            mapLit(map, gate->rhs1));
+    }
+    for (unsigned i = 0; i < src->num_latches; i++)
+        dst->latches[firstLatch + i].next = mapLit(map,
+                                                   src->latches[i].next);
+    assert(src->num_outputs == 1);
+    unsigned output = mapLit(map, src->outputs[0].lit);
+    free(map);
+    return output;
+}
+
+/* Replace the literals in lits by their disjunction, built as a balanced
+ * tree of and gates (with negations) so that its depth is logarithmic in
+ * size rather than linear
+ */
+static unsigned orTree(aiger* dst, GateTable* table,
+                       unsigned* lits, unsigned size) {
+    assert(size > 0);
+    while (size > 1) {
+        // combine neighbouring pairs, an odd one out moves up a level
+        unsigned j = 0;
+        for (unsigned i = 0; i + 1 < size; i += 2) {
+            lits[j++] = aiger_not(and(dst, table, aiger_not(lits[i]),
+                                      aiger_not(lits[i + 1])));
+        }
+        if (size % 2 == 1)
+            lits[j++] = lits[size - 1];
+        size = j;
+    }
+    return lits[0];
+}
+
+/* Copy src into a fresh AIG in which every latch i is replaced by the
+ * latch of its representative rep[i] <= i, and all gates are structurally
+ * hashed; the (new) literal of the next-state function of every latch i
+ * of src is stored in next[i]
+ * NOTE: src must be reencoded
+ */
+static aiger* substituteLatches(aiger* src, unsigned* rep, unsigned* next) {
+    aiger* res = aiger_init_arena();
+    GateTable table = {NULL, 0, 0};
+    unsigned* map = malloc((src->maxvar + 1) * sizeof(unsigned));
+    unsigned* idx = malloc((src->num_latches + 1) * sizeof(unsigned));
+    aiger_reserve(res, src->num_inputs, src->num_latches, src->num_ands,
+                  src->maxvar);
+    aiger_add_inputs(res, src->num_inputs, src->inputs);
+    map[0] = aiger_false;
+    for (unsigned i = 0; i < src->num_inputs; i++)
+        map[aiger_lit2var(src->inputs[i].lit)] = src->inputs[i].lit;
+    for (unsigned i = 0; i < src->num_latches; i++) {
+        aiger_symbol* latch = src->latches + i;
+        if (rep[i] != i) {
+            assert(rep[i] < i);
+            map[aiger_lit2var(latch->lit)] =
+                map[aiger_lit2var(src->latches[rep[i]].lit)];
+            continue;
+        }
+        unsigned lit = res->maxvar * 2 + 2;
+        idx[i] = res->num_latches;
+        aiger_add_latch(res, lit, aiger_false, latch->name);
+        aiger_add_reset(res, lit,
+                        latch->reset == latch->lit ? lit : latch->reset);
+        map[aiger_lit2var(latch->lit)] = lit;
+    }
+    for (unsigned i = 0; i < src->num_ands; i++) {
+        aiger_and* gate = src->ands + i;
+        map[aiger_lit2var(gate->lhs)] = and(res, &table,
+                                            mapLit(map, gate->rhs0),
+                                            mapLit(map, gate->rhs1));
+    }
+    for (unsigned i = 0; i < src->num_latches; i++) {
+        next[i] = mapLit(map, src->latches[i].next);
+        if (rep[i] == i)
+            res->latches[idx[i]].next = next[i];
+    }
+    for (unsigned i = 0; i < src->num_outputs; i++)
+        aiger_add_output(res, mapLit(map, src->outputs[i].lit),
+                         src->outputs[i].name);
+    for (unsigned i = 0; i < src->num_bad; i++)
+        aiger_add_bad(res, mapLit(map, src->bad[i].lit), src->bad[i].name);
+    free(idx);
+    free(map);
+    free(table.gates);
+    return res;
+}
+
+/* Latches are sorted into candidate classes by a key: first the reset
+ * value and a simulation signature, later the class and the next-state
+ * literal; the class representative is the smallest index with its key
+ */
+typedef struct {
+    uint64_t key0;
+    uint64_t key1;
+    unsigned idx;
+} LatchKey;
+
+static int cmpLatchKey(const void* a, const void* b) {
+    const LatchKey* x = a;
+    const LatchKey* y = b;
+    if (x->key0 != y->key0)
+        return x->key0 < y->key0 ? -1 : 1;
+    if (x->key1 != y->key1)
+        return x->key1 < y->key1 ? -1 : 1;
+    return (x->idx > y->idx) - (x->idx < y->idx);
+}
+
+/* Set rep[i] to the representative of latch i in the partition given by
+ * the keys, the result is non zero if some representative changed
+ */
+static bool partitionLatches(LatchKey* keys, unsigned size, unsigned* rep) {
+    bool changed = false;
+    qsort(keys, size, sizeof(LatchKey), cmpLatchKey);
+    unsigned first = 0;
+    for (unsigned i = 0; i < size; i++) {
+        if (keys[i].key0 != keys[first].key0
+                || keys[i].key1 != keys[first].key1)
+            first = i;
+        if (rep[keys[i].idx] != keys[first].idx)
+            changed = true;
+        rep[keys[i].idx] = keys[first].idx;
+    }
+    return changed;
+}
+
+static inline uint64_t simLit(uint64_t* val, unsigned lit) {
+    uint64_t ret = val[aiger_lit2var(lit)];
+    return aiger_sign(lit) ? ~ret : ret;
+}
+
+#define SIM_ROUNDS 64
+
+/* Merge latches of aig that always hold the same value (a latch
+ * correspondence): candidates are the latches with the same reset value
+ * and the same values in a bit-parallel random simulation from reset;
+ * then the candidate classes are refined until they are inductive, that
+ * is, until replacing each latch by its representative makes the
+ * next-state functions of every class structurally equal
+ * NOTE: aig is consumed, the result is a new structure
+ */
+static aiger* mergeLatches(aiger* aig) {
+    aiger_reencode(aig);
+    unsigned noLatches = aig->num_latches;
+    unsigned* rep = malloc((noLatches + 1) * sizeof(unsigned));
+    unsigned* next = malloc((noLatches + 1) * sizeof(unsigned));
+    LatchKey* keys = malloc((noLatches + 1) * sizeof(LatchKey));
+
+    // Step 1: random simulation, 64 runs in parallel, from reset
+    uint64_t* val = malloc((aig->maxvar + 1) * sizeof(uint64_t));
+    uint64_t* nextVal = malloc((noLatches + 1) * sizeof(uint64_t));
+    uint64_t* sig = calloc(noLatches + 1, sizeof(uint64_t));
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    val[0] = 0;
+    for (unsigned i = 0; i < noLatches; i++) {
+        aiger_symbol* latch = aig->latches + i;
+        val[aiger_lit2var(latch->lit)] =
+            latch->reset == aiger_true ? ~0ull : 0;
+    }
+    for (int round = 0; round < SIM_ROUNDS; round++) {
+        for (unsigned i = 0; i < aig->num_inputs; i++) {
+            // xorshift64
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            val[aiger_lit2var(aig->inputs[i].lit)] = seed;
+        }
+        for (unsigned i = 0; i < noLatches; i++) {
+            uint64_t v = val[aiger_lit2var(aig->latches[i].lit)];
+            sig[i] = (sig[i] * 1099511628211ull) ^ v;
+        }
+        for (unsigned i = 0; i < aig->num_ands; i++) {
+            aiger_and* gate = aig->ands + i;
+            val[aiger_lit2var(gate->lhs)] = simLit(val, gate->rhs0)
+                                            & simLit(val, gate->rhs1);
+        }
+        for (unsigned i = 0; i < noLatches; i++)
+            nextVal[i] = simLit(val, aig->latches[i].next);
+        for (unsigned i = 0; i < noLatches; i++)
+            val[aiger_lit2var(aig->latches[i].lit)] = nextVal[i];
+    }
+    free(nextVal);
+    free(val);
+
+    // Step 2: initial classes, uninitialized latches stay on their own
+    for (unsigned i = 0; i < noLatches; i++) {
+        aiger_symbol* latch = aig->latches + i;
+        keys[i].idx = i;
+        keys[i].key1 = sig[i];
+        if (latch->reset == latch->lit)
+            keys[i].key0 = 2 + (uint64_t) i;
+        else
+            keys[i].key0 = latch->reset;
+        rep[i] = i;
+    }
+    free(sig);
+    partitionLatches(keys, noLatches, rep);
+
+    // Step 3: refine the classes until they are inductive
+    aiger* res = substituteLatches(aig, rep, next);
+    for (;;) {
+        for (unsigned i = 0; i < noLatches; i++) {
+            keys[i].idx = i;
+            keys[i].key0 = rep[i];
+            keys[i].key1 = next[i];
+        }
+        if (!partitionLatches(keys, noLatches, rep))
+            break;
+        aiger_reset(res);
+        res = substituteLatches(aig, rep, next);
+    }
+#ifndef NDEBUG
+    fprintf(stderr, "Merged %u latches into %u\n",
+            noLatches, res->num_latches);
+#endif
+
+    free(keys);
+    free(next);
+    free(rep);
+    aiger_reset(aig);
+    return res;
+}
+
+/* Reduce aig to the cone of influence of its outputs and bad-state
+ * literals: the gates and latches they depend on, including through the
+ * next-state functions of latches; the inputs are all kept so that the
+ * interface does not change
+ * If removed is not NULL, the numbers of gates and latches outside of the
+ * cone are added to removed[0] and removed[1]
+ * NOTE: this reencodes aig, so its literals are invalidated
+ */
+static void coneOfInfluence(aiger* aig, unsigned* removed) {
+    unsigned noAnds = aig->num_ands;
+    unsigned noLatches = aig->num_latches;
+    aiger_compact_coi(aig);
+#ifndef NDEBUG
+    fprintf(stderr, "Cone of influence keeps %u of %u gates and %u of %u "
+                    "latches\n", aig->num_ands, noAnds,
+            aig->num_latches, noLatches);
+#endif
+    if (removed != NULL) {
+        removed[0] += noAnds - aig->num_ands;
+        removed[1] += noLatches - aig->num_latches;
+    }
+}
+
+/* The components of the product: each is either a file, named by its path,
+ * or an AIG already read into memory from a concatenated stream (see
+ * readConcat), in which case bytes is its NUL-terminated text and name is
+ * only used in messages
+ */
+typedef struct {
+    char** names;
+    char** bytes;
+    size_t* sizes;
+    unsigned size;
+    unsigned capacity;
+} ComponentList;
+
+static void pushComponent(ComponentList* list, char* name, char* bytes,
+                          size_t size) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 16;
+        list->names = realloc(list->names, list->capacity * sizeof(char*));
+        list->bytes = realloc(list->bytes, list->capacity * sizeof(char*));
+        list->sizes = realloc(list->sizes, list->capacity * sizeof(size_t));
+    }
+    list->names[list->size] = name;
+    list->bytes[list->size] = bytes;
+    list->sizes[list->size] = size;
+    list->size++;
+}
+
+static void deleteComponents(ComponentList* list) {
+    for (unsigned i = 0; i < list->size; i++) {
+        free(list->names[i]);
+        free(list->bytes[i]);
+    }
+    free(list->names);
+    free(list->bytes);
+    free(list->sizes);
+}
+
+/* Add the component named by a command-line argument: a path, or @FILE to
+ * add the paths listed in FILE (one per line), where @- reads the list from
+ * the standard input
+ */
+static bool addComponents(ComponentList* list, const char* arg) {
+    if (arg[0] != '@') {
+        pushComponent(list, strdup(arg), NULL, 0);
+        return true;
+    }
+    bool fromStdin = strcmp(arg + 1, "-") == 0;
+    FILE* file = fromStdin ? stdin : fopen(arg + 1, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open list file %s\n", arg + 1);
+        return false;
+    }
+    char* line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    while ((length = getline(&line, &capacity, file)) != -1) {
+        while (length > 0 && (line[length - 1] == '\n'
+                              || line[length - 1] == '\r'))
+            line[--length] = '\0';
+        if (length > 0)
+            pushComponent(list, strdup(line), NULL, 0);
+    }
+    free(line);
+    bool ok = !ferror(file);
+    if (!fromStdin)
+        fclose(file);
+    return ok;
+}
+
+/* Add the AIGs of a concatenated stream: each is preceded by its length in
+ * bytes, in decimal on a line of its own, so a producer can pipe all
+ * components (in ASCII or binary AIGER) through a single file descriptor
+ */
+static bool readConcat(ComponentList* list, FILE* file, const char* name) {
+    size_t size;
+    unsigned count = 0;
+    while (fscanf(file, " %zu", &size) == 1) {
+        char* bytes = malloc(size + 1);
+        if (fgetc(file) != '\n' || fread(bytes, 1, size, file) != size) {
+            fprintf(stderr, "%s: AIG %u is shorter than %zu bytes\n",
+                    name, count, size);
+            free(bytes);
+            return false;
+        }
+        bytes[size] = '\0';
+        char* label = malloc(strlen(name) + 16);
+        sprintf(label, "%s#%u", name, count++);
+        pushComponent(list, label, bytes, size);
+    }
+    if (ferror(file) || !feof(file)) {
+        fprintf(stderr, "%s: expected the length of AIG %u\n", name, count);
+        return false;
+    }
+    return true;
+}
+
+/* Parse the i-th component into aig and return an error message, if any
+ */
+static const char* readComponent(ComponentList* list, unsigned i,
+                                 aiger* aig) {
+    if (list->bytes[i] == NULL)
+        return aiger_open_and_map(aig, list->names[i], 0);
+    return aiger_read_from_buffer(aig, list->bytes[i], list->sizes[i]);
+}
+
+/* A pool of worker threads which parse (and optionally reduce to their cone
+ * of influence, which also reencodes them) the input files concurrently
+ * while the main thread merges them in input order
+ * Workers stay at most window files ahead of the merge so that only a
+ * bounded number of parsed components are kept in memory
+ */
+typedef struct {
+    unsigned removedAnds;
+    unsigned removedLatches;
+    double seconds;  // to parse and reduce it
+} ComponentStats;
+
+typedef struct {
+    ComponentList* list;
+    unsigned noPaths;
+    aiger** srcs;
+    ComponentStats* stats;
+    bool* parsed;
+    unsigned nextToParse;
+    unsigned merged;
+    unsigned window;
+    bool reduce;
+    unsigned removed[2];  // gates and latches removed by the reduction
+    bool abort;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    unsigned noThreads;
+    pthread_t* threads;
+} ParsePool;
+
+static void* parseWorker(void* arg) {
+    ParsePool* pool = arg;
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->abort && pool->nextToParse < pool->noPaths
+                && pool->nextToParse >= pool->merged + pool->window)
+            pthread_cond_wait(&pool->cond, &pool->mutex);
+        if (pool->abort || pool->nextToParse >= pool->noPaths)
+            break;
+        unsigned i = pool->nextToParse++;
+        pthread_mutex_unlock(&pool->mutex);
+
+        double start = now();
+        // components are dropped as a whole once merged, so an arena
+        // spares freeing each name and array on its own
+        aiger* src = aiger_init_arena();
+        // the names are needed for the product, comments are not
+        aiger_set_read_mode(src, aiger_read_symbols);
+        const char* err = readComponent(pool->list, i, src);
+        unsigned removed[2] = {0, 0};
+        if (!err && pool->reduce)
+            coneOfInfluence(src, removed);
+
+        pthread_mutex_lock(&pool->mutex);
+        pool->removed[0] += removed[0];
+        pool->removed[1] += removed[1];
+        pool->stats[i].removedAnds = removed[0];
+        pool->stats[i].removedLatches = removed[1];
+        pool->stats[i].seconds = now() - start;
+        pool->srcs[i] = src;
+        pool->parsed[i] = true;
+        pthread_cond_broadcast(&pool->cond);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+static void startPool(ParsePool* pool, ComponentList* list,
+                      unsigned noThreads, unsigned window, bool reduce) {
+    pool->list = list;
+    pool->noPaths = list->size;
+    pool->srcs = calloc(list->size, sizeof(aiger*));
+    pool->stats = calloc(list->size, sizeof(ComponentStats));
+    pool->parsed = calloc(list->size, sizeof(bool));
+    pool->nextToParse = 0;
+    pool->merged = 0;
+    pool->window = window;
+    pool->reduce = reduce;
+    pool->removed[0] = 0;
+    pool->removed[1] = 0;
+    pool->abort = false;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+    pool->noThreads = noThreads;
+    pool->threads = malloc(noThreads * sizeof(pthread_t));
+    for (unsigned i = 0; i < noThreads; i++)
+        pthread_create(pool->threads + i, NULL, parseWorker, pool);
+}
+
+/* Wait for the i-th file to be parsed and hand it over to the caller, who
+ * then owns it; the files must be taken in order
+ * If stats is not NULL, the statistics of the file are copied to it
+ * NOTE: the result is in an error state if reading failed
+ */
+static aiger* takeParsed(ParsePool* pool, unsigned i,
+                         ComponentStats* stats) {
+    pthread_mutex_lock(&pool->mutex);
+    assert(i == pool->merged);
+    while (!pool->parsed[i])
+        pthread_cond_wait(&pool->cond, &pool->mutex);
+    aiger* src = pool->srcs[i];
+    pool->srcs[i] = NULL;
+    if (stats != NULL)
+        *stats = pool->stats[i];
+    pool->merged = i + 1;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+    return src;
+}
+
+/* Stop the workers (early, if files are left) and free what they parsed
+ */
+static void stopPool(ParsePool* pool) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->abort = true;
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->mutex);
+    for (unsigned i = 0; i < pool->noThreads; i++)
+        pthread_join(pool->threads[i], NULL);
+    for (unsigned i = 0; i < pool->noPaths; i++) {
+        if (pool->srcs[i] != NULL)
+            aiger_reset(pool->srcs[i]);
+    }
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->cond);
+    free(pool->threads);
+    free(pool->parsed);
+    free(pool->stats);
+    free(pool->srcs);
+}
+
+/* Report what the cone-of-influence reduction removed from the components
+ * NOTE: the pool must be stopped
+ */
+static void reportRemoved(ParsePool* pool) {
+    if (pool->removed[0] > 0 || pool->removed[1] > 0)
+        fprintf(stderr, "Cone of influence: removed %u gates and %u latches "
+                        "from the components\n",
+                pool->removed[0], pool->removed[1]);
+}
+
+/* The nodes of one level of the hierarchical product: worker threads take
+ * the pairs (2k, 2k + 1) in turn and replace node k by their product
+ */
+typedef struct {
+    aiger** nodes;
+    unsigned noPairs;
+    unsigned nextPair;
+    bool merge;
+    pthread_mutex_t mutex;
+} TreeLevel;
+
+/* The product of a and b, with the disjunction of their outputs, reduced
+ * to its cone of influence and, if merge is set, with latches merged
+ * NOTE: a and b are consumed, the result is a new structure
+ */
+static aiger* pairProduct(aiger* a, aiger* b, bool merge) {
+    aiger* res = aiger_init_arena();
+    GateTable table = {NULL, 0, 0};
+    InputIndex index = {NULL, NULL, 0, 0};
+    unsigned outputs[2];
+    // upper bounds, shared inputs and gates only make the product smaller
+    aiger_reserve(res, a->num_inputs + b->num_inputs,
+                  a->num_latches + b->num_latches,
+                  a->num_ands + b->num_ands + 1, a->maxvar + b->maxvar + 1);
+    outputs[0] = mergeComponent(res, &table, &index, a);
+    outputs[1] = mergeComponent(res, &table, &index, b);
+    aiger_add_output(res, orTree(res, &table, outputs, 2),
+                     "output_disjunction");
+    deleteIndex(&index);
+    free(table.gates);
+    aiger_reset(a);
+    aiger_reset(b);
+    coneOfInfluence(res, NULL);
+    if (merge)
+        res = mergeLatches(res);
+    return res;
+}
+
+static void* treeWorker(void* arg) {
+    TreeLevel* level = arg;
+    for (;;) {
+        pthread_mutex_lock(&level->mutex);
+        unsigned k = level->nextPair++;
+        pthread_mutex_unlock(&level->mutex);
+        if (k >= level->noPairs)
+            break;
+        level->nodes[2 * k] = pairProduct(level->nodes[2 * k],
+                                          level->nodes[2 * k + 1],
+                                          level->merge);
+    }
+    return NULL;
+}
+
+/* Build the product hierarchically: components are multiplied pairwise,
+ * level by level, with the pairs of a level handled in parallel; the
+ * pairing is the same as in orTree, so the result is functionally the
+ * same as the flat product
+ * Returns NULL (after reporting it) if some component cannot be read.
+ */
+static aiger* treeProduct(ComponentList* list, unsigned noThreads,
+                          bool merge) {
+    aiger** nodes = malloc(list->size * sizeof(aiger*));
+    ParsePool pool;
+    startPool(&pool, list, noThreads, 4 * noThreads, true);
+    for (unsigned i = 0; i < list->size; i++) {
+        nodes[i] = takeParsed(&pool, i, NULL);
+        const char* err = aiger_error(nodes[i]);
+        if (err) {
+            fprintf(stderr, "Reading error on %s: %s\n",
+                    list->names[i], err);
+            stopPool(&pool);
+            for (unsigned j = 0; j <= i; j++)
+                aiger_reset(nodes[j]);
+            free(nodes);
+            return NULL;
+        }
+    }
+    stopPool(&pool);
+    reportRemoved(&pool);
+
+    unsigned size = list->size;
+    pthread_t* threads = malloc(noThreads * sizeof(pthread_t));
+    while (size > 1) {
+        TreeLevel level;
+        level.nodes = nodes;
+        level.noPairs = size / 2;
+        level.nextPair = 0;
+        level.merge = merge;
+        pthread_mutex_init(&level.mutex, NULL);
+        unsigned noWorkers = noThreads < level.noPairs ? noThreads
+                                                       : level.noPairs;
+        for (unsigned i = 0; i < noWorkers; i++)
+            pthread_create(threads + i, NULL, treeWorker, &level);
+        for (unsigned i = 0; i < noWorkers; i++)
+            pthread_join(threads[i], NULL);
+        pthread_mutex_destroy(&level.mutex);
+        // compact the level, an odd one out moves up
+        unsigned j = 0;
+        for (unsigned k = 0; k < level.noPairs; k++)
+            nodes[j++] = nodes[2 * k];
+        if (size % 2 == 1)
+            nodes[j++] = nodes[size - 1];
+        size = j;
+#ifndef NDEBUG
+        fprintf(stderr, "Tree level done, %u products left\n", size);
+#endif
+    }
+    aiger* res = nodes[0];
+    free(threads);
+    free(nodes);
+    return res;
+}
+
+static bool hasSuffix(const char* str, const char* suffix) {
+    size_t len = strlen(str);
+    size_t suffixLen = strlen(suffix);
+    return len >= suffixLen && strcmp(str + len - suffixLen, suffix) == 0;
+}
+
+/* Read only the header "a[ai]g M I L O A" of the i-th component
+ * Compressed files cannot be scanned directly, so they are read by the
+ * aiger library (without symbols) and only their sizes are kept
+ * Returns NULL on success and an error message otherwise
+ */
+static const char* readHeader(ComponentList* list, unsigned i,
+                              unsigned* header) {
+    const char* invalid = "invalid header";
+    if (list->bytes[i] != NULL)
+        return sscanf(list->bytes[i], "a%*[ai]g %u %u %u %u %u", header,
+                      header + 1, header + 2, header + 3,
+                      header + 4) == 5 ? NULL : invalid;
+    if (hasSuffix(list->names[i], ".gz")
+            || hasSuffix(list->names[i], ".zst")) {
+        static char error[256];
+        aiger* aig = aiger_init();
+        aiger_set_read_mode(aig, aiger_read_no_symbols);
+        const char* err = aiger_open_and_read_from_file(aig,
+                                                        list->names[i]);
+        if (err == NULL) {
+            header[0] = aig->maxvar;
+            header[1] = aig->num_inputs;
+            header[2] = aig->num_latches;
+            header[3] = aig->num_outputs;
+            header[4] = aig->num_ands;
+        } else {
+            // the message belongs to aig, which is reset below
+            snprintf(error, sizeof(error), "%s", err);
+        }
+        aiger_reset(aig);
+        return err == NULL ? NULL : error;
+    }
+    FILE* file = fopen(list->names[i], "rb");
+    if (file == NULL)
+        return "cannot open file";
+    int read = fscanf(file, "a%*[ai]g %u %u %u %u %u", header, header + 1,
+                      header + 2, header + 3, header + 4);
+    fclose(file);
+    return read == 5 ? NULL : invalid;
+}
+
 static inline unsigned shift(unsigned lit, unsigned offset, unsigned inputs) {
     // 0 and 1 are not lits, so inputs gives us the maximal variable name
     // for a real literal. In AIGER, we hide negations between even numbers
@@ -48,87 +995,190 @@ static inline unsigned shift(unsigned lit, unsigned offset, unsigned inputs) {
     return ret;
 }
 
-/* Take and-inverter graphs with the same set of inputs
- * and construct their product
+/* Write the product of the given files in ASCII AIGER to out without
+ * building it in memory: all offsets are computed from the headers first,
+ * then every component is read (by the ParsePool, with a window of one),
+ * shifted, and streamed out, so at most the component being streamed and
+ * the next one are in memory
+ * The inputs are matched by position, and their names must agree with
+ * those of the first component.
+ * Since latches come before and gates in the format, everything but the
+ * header is spooled to temporary files, which are only copied to out if
+ * all components could be read, so nothing is written on failure.
+ * The result is the plain product (no structural hashing) with a balanced
+ * OR tree for the output, as in orTree.
  */
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        fprintf(stderr, "Expected at least 2 input AIG files as arguments.\n");
-        printHelp();
-        return EXIT_FAILURE;
+static bool streamProduct(ComponentList* list, unsigned noThreads,
+                          FILE* out) {
+    char** paths = list->names;
+    unsigned noPaths = list->size;
+    // Pass 1: headers and offsets
+    unsigned header[5];
+    unsigned inputs = 0;
+    unsigned maxvar = 0;
+    unsigned latches = 0;
+    unsigned ands = noPaths - 1;  // the OR tree
+    unsigned* offsets = malloc(noPaths * sizeof(unsigned));
+    unsigned* maxvars = malloc(noPaths * sizeof(unsigned));
+    for (unsigned i = 0; i < noPaths; i++) {
+        const char* err = readHeader(list, i, header);
+        if (err != NULL) {
+            fprintf(stderr, "Reading error on %s: %s\n", paths[i], err);
+            free(maxvars);
+            free(offsets);
+            return false;
+        }
+        if (i == 0) {
+            inputs = header[1];
+            maxvar = inputs;
+        } else if (header[1] != inputs) {
+            fprintf(stderr, "%s: Expected %d inputs but got %d\n",
+                    paths[i], inputs, header[1]);
+            free(maxvars);
+            free(offsets);
+            return false;
+        }
+        if (header[3] != 1) {
+            fprintf(stderr, "%s: Expected 1 output but got %d\n",
+                    paths[i], header[3]);
+            free(maxvars);
+            free(offsets);
+            return false;
+        }
+        offsets[i] = 2 * (maxvar - inputs);
+        maxvars[i] = header[0];
+        maxvar += header[0] - inputs;
+        latches += header[2];
+        ands += header[4];
     }
-    aiger* dst = aiger_init();
-    unsigned inputs = UINT_MAX;
-    unsigned offset = 0;
-    unsigned output = 0;
-    for (int srcidx = 1; srcidx < argc; srcidx++) {
-        char* srcPath = argv[srcidx];
+    maxvar += noPaths - 1;
+
+    // Pass 2: latches, gates and symbols are spooled
+    FILE* latchSpool = tmpfile();
+    FILE* gates = tmpfile();
+    FILE* symbols = tmpfile();
+    unsigned* outputs = malloc(noPaths * sizeof(unsigned));
+    char** names = calloc(inputs, sizeof(char*));  // of the first component
+    char buffer[1 << 16];
+    unsigned noLatches = 0;
+    bool ok = latchSpool != NULL && gates != NULL && symbols != NULL;
+    // a window of one: the next component is read while one is streamed
+    ParsePool pool;
+    startPool(&pool, list, noThreads, 1, false);
+    for (unsigned i = 0; ok && i < noPaths; i++) {
 #ifndef NDEBUG
-        fprintf(stderr, "Processing file: %s\n", srcPath);
+        fprintf(stderr, "Streaming file: %s\n", paths[i]);
 #endif
-        aiger* src = aiger_init();
-        const char* err = aiger_open_and_read_from_file(src, srcPath);
+        aiger* src = takeParsed(&pool, i, NULL);
+        const char* err = aiger_error(src);
         if (err) {
-            fprintf(stderr, "Reading error on %s: %s\n",
-                    srcPath, err);
-            aiger_reset(src);
-            aiger_reset(dst);
-            return EXIT_FAILURE;
+            fprintf(stderr, "Reading error on %s: %s\n", paths[i], err);
+            ok = false;
+        } else if (src->maxvar != maxvars[i]) {
+            // only possible if the file changed since pass 1
+            fprintf(stderr, "%s: Header changed while reading\n", paths[i]);
+            ok = false;
         }
-        // for the first file we add the inputs and remember the number of
-        // them
-        if (inputs == UINT_MAX) {
-            inputs = src->num_inputs;
-            for (int i = 0; i < src->num_inputs; i++) {
-                aiger_symbol sym = src->inputs[i];
-                aiger_add_input(dst, sym.lit, sym.name);
-            }
-        } else {
-            if (src->num_inputs != inputs) {
-                fprintf(stderr, "%s: Expected %d inputs but got %d\n",
-                        srcPath, inputs, src->num_inputs);
-                aiger_reset(dst);
-                aiger_reset(src);
-                return EXIT_FAILURE;
+        for (unsigned j = 0; ok && j < src->num_inputs; j++) {
+            const char* name = inputName(src, j, buffer);
+            if (src->inputs[j].lit != 2 * (j + 1)) {
+                fprintf(stderr, "%s: Input %u is not literal %u\n",
+                        paths[i], j, 2 * (j + 1));
+                ok = false;
+            } else if (i == 0) {
+                names[j] = strdup(name);
+                if (src->inputs[j].name != NULL)
+                    fprintf(symbols, "i%u %s\n", j, name);
+            } else if (strcmp(name, names[j]) != 0) {
+                // the other modes match inputs by name, so would not agree
+                fprintf(stderr, "%s: Input %u is %s but %s in %s\n",
+                        paths[i], j, name, names[j], paths[0]);
+                ok = false;
             }
         }
-
-        // add gates, latches, and outputs to dst
-#ifndef NDEBUG
-        fprintf(stderr, "Adding gates, etc. with offset %d\n", offset);
-#endif
-        for (int i = 0; i < src->num_ands; i++) {
-            aiger_and and = src->ands[i]; 
-            aiger_add_and(dst, shift(and.lhs, offset, inputs),
-                          shift(and.rhs0, offset, inputs),
-                          shift(and.rhs1, offset, inputs));
-        }
-        for (int i = 0; i < src->num_latches; i++) {
-            aiger_symbol latch = src->latches[i];
-            aiger_add_latch(dst, shift(latch.lit, offset, inputs),
-                            shift(latch.next, offset, inputs),
-                            latch.name);
-        }
-        assert(src->num_outputs == 1);
-        aiger_symbol out = src->outputs[0];
-        unsigned oldOutput = output;
-        output = dst->maxvar * 2 + 2;
-        // we construct the or of the old one with the new one
-        // so we negate them, take an and
-        aiger_add_and(dst, output, aiger_not(oldOutput),
-                      aiger_not(shift(out.lit, offset, inputs)));
-        // and consider its negation too
-        output = aiger_not(output); 
-        // clean up the aiger structure for this file
+        for (unsigned j = 0; ok && j < src->num_latches; j++) {
+            aiger_symbol* latch = src->latches + j;
+            unsigned lit = shift(latch->lit, offsets[i], inputs);
+            fprintf(latchSpool, "%u %u", lit,
+                    shift(latch->next, offsets[i], inputs));
+            if (latch->reset != aiger_false)
+                fprintf(latchSpool, " %u",
+                        latch->reset == latch->lit ? lit : latch->reset);
+            fputc('\n', latchSpool);
+            if (latch->name != NULL)
+                fprintf(symbols, "l%u %s\n", noLatches, latch->name);
+            noLatches++;
+        }
+        for (unsigned j = 0; ok && j < src->num_ands; j++) {
+            aiger_and* gate = src->ands + j;
+            fprintf(gates, "%u %u %u\n", shift(gate->lhs, offsets[i], inputs),
+                    shift(gate->rhs0, offsets[i], inputs),
+                    shift(gate->rhs1, offsets[i], inputs));
+        }
+        if (ok)
+            outputs[i] = shift(src->outputs[0].lit, offsets[i], inputs);
         aiger_reset(src);
+    }
+    stopPool(&pool);
 
-        // update the offset
-        offset = dst->maxvar * 2;
+    // the OR tree, with the same shape as the one of orTree
+    if (ok) {
+        unsigned size = noPaths;
+        unsigned lhs = 2 * (maxvar - (noPaths - 1));
+        while (size > 1) {
+            unsigned j = 0;
+            for (unsigned i = 0; i + 1 < size; i += 2) {
+                lhs += 2;
+                fprintf(gates, "%u %u %u\n", lhs, aiger_not(outputs[i]),
+                        aiger_not(outputs[i + 1]));
+                outputs[j++] = aiger_not(lhs);
+            }
+            if (size % 2 == 1)
+                outputs[j++] = outputs[size - 1];
+            size = j;
+        }
+        fprintf(symbols, "o0 output_disjunction\n");
+    }
+
+    // all components are fine, so write the header, the inputs, and copy
+    // the spooled latches, gates and symbols with the output in between
+    if (ok) {
+        fprintf(out, "aag %u %u %u 1 %u\n", maxvar, inputs, latches, ands);
+        for (unsigned i = 0; i < inputs; i++)
+            fprintf(out, "%u\n", 2 * (i + 1));
+    }
+    size_t bytes;
+    for (int k = 0; ok && k < 3; k++) {
+        FILE* spool = k == 0 ? latchSpool : k == 1 ? gates : symbols;
+        if (k == 1)
+            fprintf(out, "%u\n", outputs[0]);
+        rewind(spool);
+        while ((bytes = fread(buffer, 1, sizeof(buffer), spool)) > 0)
+            fwrite(buffer, 1, bytes, out);
+        if (ferror(spool))
+            ok = false;
     }
 
-    // add a final output
-    aiger_add_output(dst, output, "output_disjunction");
+    for (unsigned i = 0; i < inputs; i++)
+        free(names[i]);
+    free(names);
+    if (latchSpool != NULL)
+        fclose(latchSpool);
+    if (gates != NULL)
+        fclose(gates);
+    if (symbols != NULL)
+        fclose(symbols);
+    free(outputs);
+    free(maxvars);
+    free(offsets);
+    return ok && !ferror(out);
+}
 
+/* Check (in debug builds) and write the product, or its unrolling, to the
+ * standard output
+ * NOTE: dst is consumed
+ */
+static bool writeProduct(aiger* dst, bool cnf, int bound) {
 #ifndef NDEBUG
     fprintf(stderr, "AIG structure created, now checking it!\n");
     const char* msg = aiger_check(dst);
@@ -137,11 +1187,320 @@ int main(int argc, char* argv[]) {
     }
 #endif
 
-    // and dump the aig
-    aiger_write_to_file(dst, aiger_ascii_mode, stdout);
+    // and dump the aig, or its unrolling
+    int ok;
+    if (cnf)
+        ok = writeUnrolledCnf(dst, bound, stdout);
+    else
+        ok = aiger_write_to_file(dst, aiger_ascii_mode, stdout);
 
     // Free dynamic memory
     aiger_reset(dst);
-    return EXIT_SUCCESS;
+    if (!ok)
+        fprintf(stderr, "Writing error!\n");
+    return ok;
+}
+
+/* Write the records of a component just merged into dst to the map file:
+ * its sizes and timings, the position, literal and name in dst of each of
+ * its latches, the range of gate literals added for it (gates it shares
+ * with earlier components are not repeated), and its output literal
+ */
+static void mapComponent(FILE* map, unsigned idx, const char* name,
+                         aiger* src, aiger* dst, unsigned firstLatch,
+                         unsigned firstAnd, unsigned output,
+                         ComponentStats* stats, double seconds) {
+    fprintf(map, "component %u %s\n", idx, name);
+    fprintf(map, "size %u inputs %u latches %u ands %u removed_latches %u "
+                 "removed_ands %u\n", idx, src->num_inputs,
+            src->num_latches, src->num_ands, stats->removedLatches,
+            stats->removedAnds);
+    fprintf(map, "time %u parse_seconds %f merge_seconds %f\n", idx,
+            stats->seconds, seconds);
+    for (unsigned i = firstLatch; i < dst->num_latches; i++) {
+        aiger_symbol* latch = dst->latches + i;
+        fprintf(map, "latch %u %u %u %s\n", idx, i, latch->lit,
+                latch->name != NULL ? latch->name : "-");
+    }
+    if (firstAnd < dst->num_ands)
+        fprintf(map, "gates %u %u %u %u\n", idx, dst->num_ands - firstAnd,
+                dst->ands[firstAnd].lhs, dst->ands[dst->num_ands - 1].lhs);
+    else
+        fprintf(map, "gates %u 0\n", idx);
+    fprintf(map, "output %u %u\n", idx, output);
+}
+
+/* Parse the unrolling bound of -k, a non-negative int without trailing
+ * characters
+ */
+static bool parseBound(const char* str, int* bound) {
+    char* end;
+    errno = 0;
+    long k = strtol(str, &end, 10);
+    if (end == str || *end != '\0' || errno == ERANGE || k < 0
+            || k > INT_MAX)
+        return false;
+    *bound = (int) k;
+    return true;
+}
+
+/* Take and-inverter graphs, whose inputs are matched by name,
+ * and construct their product, structurally hashing all gates
+ * The files are parsed in parallel but merged in order, so the result does
+ * not depend on the number of threads
+ */
+int main(int argc, char* argv[]) {
+    int c;
+    int bound = -1;
+    int cnf = 0;
+    int merge = 0;
+    int stream = 0;
+    int append = 0;
+    int tree = 0;
+    const char* concat = NULL;
+    const char* mapName = NULL;
+    long noThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    static struct option longOptions[] = {
+        {"append", no_argument, NULL, 'a'},
+        {"cnf", no_argument, NULL, 'c'},
+        {"concat", optional_argument, NULL, 'C'},
+        {"map", required_argument, NULL, 'M'},
+        {"merge-latches", no_argument, NULL, 'm'},
+        {"stream", no_argument, NULL, 's'},
+        {"tree", no_argument, NULL, 't'},
+        {NULL, 0, NULL, 0}
+    };
+    while ((c = getopt_long(argc, argv, "hj:k:", longOptions, NULL)) != -1) {
+        switch (c) {
+            case 'a':
+                append = 1;
+                break;
+            case 'c':
+                cnf = 1;
+                break;
+            case 'C':
+                concat = optarg != NULL ? optarg : "-";
+                break;
+            case 'm':
+                merge = 1;
+                break;
+            case 'M':
+                mapName = optarg;
+                break;
+            case 's':
+                stream = 1;
+                break;
+            case 't':
+                tree = 1;
+                break;
+            case 'j':
+                noThreads = atoi(optarg);
+                break;
+            case 'k':
+                if (!parseBound(optarg, &bound)) {
+                    fprintf(stderr, "Invalid bound: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'h':
+                printHelp();
+                break;
+            case '?':  // getopt found an invalid option
+                return EXIT_FAILURE;
+            default:
+                assert(false);  // this should not be reachable
+        }
+    }
+    // the unrolling bound and the CNF mode only make sense together
+    if (cnf != (bound >= 0)) {
+        fprintf(stderr, "Expected both -k K and --cnf, or neither!\n");
+        return EXIT_FAILURE;
+    }
+    // collect the components: arguments (or the files listed in @FILE
+    // arguments) first, then those of the concatenated stream
+    ComponentList list = {NULL, NULL, NULL, 0, 0};
+    bool listed = true;
+    for (int i = optind; listed && i < argc; i++) {
+        if (concat != NULL && strcmp(concat, "-") == 0
+                && strcmp(argv[i], "@-") == 0) {
+            fprintf(stderr, "Cannot read both @- and --concat from the "
+                            "standard input\n");
+            listed = false;
+        } else {
+            listed = addComponents(&list, argv[i]);
+        }
+    }
+    if (listed && concat != NULL) {
+        bool fromStdin = strcmp(concat, "-") == 0;
+        FILE* file = fromStdin ? stdin : fopen(concat, "rb");
+        if (file == NULL) {
+            fprintf(stderr, "Could not open %s\n", concat);
+            listed = false;
+        } else {
+            listed = readConcat(&list, file, fromStdin ? "<stdin>" : concat);
+            if (!fromStdin)
+                fclose(file);
+        }
+    }
+    if (!listed) {
+        deleteComponents(&list);
+        return EXIT_FAILURE;
+    }
+    if (list.size < 2) {
+        fprintf(stderr, "Expected at least 2 input AIGs.\n");
+        printHelp();
+        deleteComponents(&list);
+        return EXIT_FAILURE;
+    }
+    if (noThreads < 1)
+        noThreads = 1;
+    if (stream) {
+        if (cnf || merge || append || tree) {
+            fprintf(stderr, "--stream cannot be combined with --cnf, "
+                            "--merge-latches, --append or --tree\n");
+            deleteComponents(&list);
+            return EXIT_FAILURE;
+        }
+        bool ok = streamProduct(&list, noThreads, stdout);
+        deleteComponents(&list);
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (tree && append) {
+        fprintf(stderr, "--tree cannot be combined with --append\n");
+        deleteComponents(&list);
+        return EXIT_FAILURE;
+    }
+    // the map refers to the literals and latches of the flat product
+    if (mapName != NULL && (tree || merge || cnf)) {
+        fprintf(stderr, "--map cannot be combined with --tree, "
+                        "--merge-latches or --cnf\n");
+        deleteComponents(&list);
+        return EXIT_FAILURE;
+    }
+    FILE* map = NULL;
+    if (mapName != NULL) {
+        map = fopen(mapName, "w");
+        if (map == NULL) {
+            fprintf(stderr, "Could not open %s\n", mapName);
+            deleteComponents(&list);
+            return EXIT_FAILURE;
+        }
+        fprintf(map, "# aigprod map: component IDX NAME, size IDX ..., "
+                     "time IDX ..., latch IDX POS LIT NAME,\n"
+                     "# gates IDX COUNT FIRSTLIT LASTLIT, output IDX LIT, "
+                     "total ...\n");
+    }
+    if (tree) {
+        aiger* dst = treeProduct(&list, noThreads, merge);
+        deleteComponents(&list);
+        if (dst == NULL)
+            return EXIT_FAILURE;
+        return writeProduct(dst, cnf, bound) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    aiger* dst = aiger_init();
+    GateTable table = {NULL, 0, 0};
+    InputIndex index = {NULL, NULL, 0, 0};
+    // with --append, the first AIG is an existing product which we extend
+    // as it is, without re-merging its components
+    unsigned first = 0;
+    if (append) {
+        const char* err = readComponent(&list, 0, dst);
+        if (!err && dst->num_outputs > 1)
+            err = "expected at most one output";
+        if (!err && dst->num_outputs == 0 && dst->num_bad == 0)
+            err = "expected an output or bad-state literals";
+        if (err) {
+            fprintf(stderr, "Reading error on %s: %s\n", list.names[0],
+                    err);
+            aiger_reset(dst);
+            deleteComponents(&list);
+            return EXIT_FAILURE;
+        }
+        hashGates(&table, dst);
+        indexInputs(&index, dst);
+        first = 1;
+    }
+    ComponentList added = {list.names + first, list.bytes + first,
+                           list.sizes + first, list.size - first, 0};
+    ParsePool pool;
+    startPool(&pool, &added, noThreads, 4 * noThreads, true);
+    unsigned noOutputs = 0;
+    unsigned* outputs = malloc(added.size * sizeof(unsigned));
+    double mergeSeconds = 0;
+    for (unsigned srcidx = 0; srcidx < added.size; srcidx++) {
+        char* srcPath = added.names[srcidx];
+#ifndef NDEBUG
+        fprintf(stderr, "Processing file: %s\n", srcPath);
+#endif
+        ComponentStats stats;
+        aiger* src = takeParsed(&pool, srcidx, &stats);
+        const char* err = aiger_error(src);
+        if (err) {
+            fprintf(stderr, "Reading error on %s: %s\n",
+                    srcPath, err);
+            if (map != NULL)
+                fclose(map);
+            aiger_reset(src);
+            aiger_reset(dst);
+            stopPool(&pool);
+            deleteIndex(&index);
+            deleteComponents(&list);
+            free(table.gates);
+            free(outputs);
+            return EXIT_FAILURE;
+        }
+        // add gates, latches, and outputs to dst, we remember the output
+        // as the disjunction is built at the end
+        unsigned firstLatch = dst->num_latches;
+        unsigned firstAnd = dst->num_ands;
+        double start = now();
+        outputs[noOutputs] = mergeComponent(dst, &table, &index, src);
+        double seconds = now() - start;
+        mergeSeconds += seconds;
+        if (map != NULL)
+            mapComponent(map, srcidx, srcPath, src, dst, firstLatch,
+                         firstAnd, outputs[noOutputs], &stats, seconds);
+        noOutputs++;
+#ifndef NDEBUG
+        fprintf(stderr, "Product now has %u gates and %u latches\n",
+                dst->num_ands, dst->num_latches);
+#endif
+        // clean up the aiger structure for this file
+        aiger_reset(src);
+    }
+    stopPool(&pool);
+    reportRemoved(&pool);
+    deleteIndex(&index);
+    deleteComponents(&list);
+
+    // add a final output, or extend the one (or the bad set) of the product
+    // we append to
+    if (append && dst->num_outputs == 0) {
+        for (unsigned i = 0; i < noOutputs; i++)
+            aiger_add_bad(dst, outputs[i], NULL);
+    } else {
+        unsigned output = orTree(dst, &table, outputs, noOutputs);
+        if (append)
+            dst->outputs[0].lit = aiger_not(and(dst, &table,
+                                                aiger_not(dst->outputs[0].lit),
+                                                aiger_not(output)));
+        else
+            aiger_add_output(dst, output, "output_disjunction");
+    }
+    free(outputs);
+    free(table.gates);
+    if (map != NULL) {
+        fprintf(map, "total inputs %u latches %u ands %u merge_seconds %f\n",
+                dst->num_inputs, dst->num_latches, dst->num_ands,
+                mergeSeconds);
+        if (fclose(map) != 0) {
+            fprintf(stderr, "Writing error on %s\n", mapName);
+            aiger_reset(dst);
+            return EXIT_FAILURE;
+        }
+    }
+    if (merge)
+        dst = mergeLatches(dst);
+    return writeProduct(dst, cnf, bound) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
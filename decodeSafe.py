@@ -20,6 +20,31 @@ def is_negated(lit):
     return (lit & 1) == 1
 
 
+def read_map(file_name):
+    # the latch widths of every component from an aigprod --map file:
+    # a list of (exec_latches, arrival_latches) in component order, where
+    # a component without latch records (e.g. all of them merged with
+    # those of earlier components) has no latches of its own
+    widths = {}
+    f = open(file_name, "r")
+    for line in f:
+        fields = line.split()
+        if len(fields) >= 2 and fields[0] == "component":
+            widths.setdefault(int(fields[1]), (0, 0))
+            continue
+        if len(fields) < 5 or fields[0] != "latch":
+            continue
+        comp = int(fields[1])
+        (e, a) = widths.get(comp, (0, 0))
+        if fields[4].startswith("exec_counter_latch"):
+            e += 1
+        elif fields[4].startswith("arrival_counter_latch"):
+            a += 1
+        widths[comp] = (e, a)
+    f.close()
+    return [widths[c] for c in sorted(widths)]
+
+
 class AIG(object):
     def is_and(self, lit):
         stripped = strip_lit(lit)
@@ -62,7 +87,7 @@ class AIG(object):
 
     def decode(self, exec_times, arrival_times,
                max_exec_times, max_arrival_times,
-               sched_task):
+               sched_task, map_file_name=None):
         # I am assuming there are only ands and inputs
         assert self.aig.num_latches == 0, "Did not expect latches"
         # Other sanity checks
@@ -72,10 +97,17 @@ class AIG(object):
             "Different number of maximal times"
         assert len(exec_times) == len(max_exec_times),\
             "Exec and maximal exec times differ"
-        exec_latches = [math.floor(math.log(m, 2)) + 1
-                        for m in max_exec_times]
-        arrival_latches = [math.floor(math.log(m, 2)) + 1
-                           for m in max_arrival_times]
+        if map_file_name is None:
+            exec_latches = [math.floor(math.log(m, 2)) + 1
+                            for m in max_exec_times]
+            arrival_latches = [math.floor(math.log(m, 2)) + 1
+                               for m in max_arrival_times]
+        else:
+            widths = read_map(map_file_name)
+            assert len(widths) == len(exec_times),\
+                "The map has a different number of tasks"
+            exec_latches = [e for (e, _) in widths]
+            arrival_latches = [a for (_, a) in widths]
         no_latches = sum(exec_latches) + sum(arrival_latches)
         aig_latches = self.aig.num_inputs - (2 * len(exec_times))
         assert no_latches == aig_latches,\
@@ -115,12 +147,14 @@ class AIG(object):
 
 
 def main():
-    if len(sys.argv) != 2:
-        print("Expected an AIG file name as unique argument")
+    if len(sys.argv) not in [2, 3]:
+        print("Expected an AIG file name as argument")
+        print("(optionally followed by an aigprod --map file)")
         exit(1)
     else:
         aig = AIG(sys.argv[1])
-        exit(aig.decode([2, 2], [7, 7], [2, 2], [9, 8], 0))
+        map_file_name = sys.argv[2] if len(sys.argv) == 3 else None
+        exit(aig.decode([2, 2], [7, 7], [2, 2], [9, 8], 0, map_file_name))
 
 
 if __name__ == "__main__":
@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 
+import os
 import sys
 import subprocess
 from fractions import Fraction
@@ -81,40 +82,85 @@ def get_tasks(file_name):
     return hard_tasks, soft_tasks
 
 
-def encode(file_name):
+def task_args(no_tasks, index, task):
+    (init_arrival, exe_dist, deadline, period_dist, _, _) = task
+    exec_times = sorted([x for (x, _) in exe_dist])
+    arrival_times = sorted([x for (x, _) in period_dist])
+    args = [no_tasks, index, deadline,
+            init_arrival, exec_times[-1],
+            arrival_times[-1]]
+    extra_exec = ["-e {}".format(e) for e in exec_times[:-1]]
+    extra_arrival = ["-a {}".format(a) for a in arrival_times[:-1]]
+    return [str(a) for a in extra_exec + extra_arrival + args]
+
+
+def estimate(file_name):
+    hard_tasks, _ = get_tasks(file_name)
+    # we ask task2aig for the estimate of each task and then account for
+    # the product: inputs are shared, latches and gates add up, and aigprod
+    # adds a tree of len(hard_tasks) - 1 gates for the output disjunction
+    total = {"inputs": 0, "latches": 0,
+             "ands_max": max(len(hard_tasks) - 1, 0),
+             "state_bits": 0, "reachable_states_est": 1}
+    i = 1
+    for task in hard_tasks:
+        args = task_args(len(hard_tasks), i, task)
+        completed = subprocess.run(["./task2aig", "--estimate"] + args,
+                                   stdout=subprocess.PIPE,
+                                   stderr=subprocess.PIPE)
+        if completed.returncode != 0:
+            print("An error occurred: {}".format(str(completed.stderr)))
+            return completed.returncode
+        est = dict((k, int(v)) for (k, v) in
+                   [line.split() for line in
+                    completed.stdout.decode().splitlines()])
+        print("task{} {}".format(i, " ".join(
+            "{}={}".format(k, v) for (k, v) in est.items())))
+        total["inputs"] = max(total["inputs"], est["inputs"])
+        total["latches"] += est["latches"]
+        total["ands_max"] += est["ands_max"]
+        total["state_bits"] += est["state_bits"]
+        total["reachable_states_est"] *= est["reachable_states_est"]
+        i += 1
+    total["maxvar_max"] = (total["inputs"] + total["latches"] +
+                           total["ands_max"])
+    for (k, v) in total.items():
+        print("{} {}".format(k, v))
+    return 0
+
+
+def encode(file_name, out_name="tasks.aag", map_name=None):
+    # the map of the product goes next to it unless given explicitly
+    if map_name is None:
+        map_name = os.path.splitext(out_name)[0] + ".map"
     hard_tasks, _ = get_tasks(file_name)
     # hard_tasks and soft_tasks are a list of task descriptions:
     # [arrival, exe dist, deadline, period dist, max_exe_time, min_arrive_time]
     print("Found {} hard tasks".format(len(hard_tasks)))
     print("Proceeding to encode them into AIGER")
     i = 1
-    for (init_arrival, exe_dist, deadline, period_dist, _, _) in hard_tasks:
-        exec_times = sorted([x for (x, _) in exe_dist])
-        arrival_times = sorted([x for (x, _) in period_dist])
-        args = [len(hard_tasks), i, deadline,
-                init_arrival, exec_times[-1],
-                arrival_times[-1]]
-        extra_exec = ["-e {}".format(e) for e in exec_times[:-1]]
-        extra_arrival = ["-a {}".format(a) for a in arrival_times[:-1]]
-        args = [str(a) for a in extra_exec + extra_arrival + args]
-
-        # Call the aig encoder and save the aig to a temporary file
+    # the AIG of every task, each preceded by its length in bytes, so that
+    # aigprod can read them all from its standard input (see --concat)
+    components = []
+    for task in hard_tasks:
+        args = task_args(len(hard_tasks), i, task)
+
+        # Call the aig encoder and keep the aig in memory
         completed = subprocess.run(["./task2aig"] + args,
                                    stdout=subprocess.PIPE,
                                    stderr=subprocess.PIPE)
         if completed.returncode != 0:
             print("An error occurred: {}".format(str(completed.stderr)))
             return completed.returncode
-        f = open("temp{}.aag".format(i), "wb")
-        f.write(completed.stdout)
-        f.close()
+        components.append(str(len(completed.stdout)).encode() + b"\n")
+        components.append(completed.stdout)
         i += 1
-    temp_files = ["temp{}.aag".format(i)
-                  for i in range(1, len(hard_tasks) + 1)]
     print("We now have an AIGER for each task")
-    if len(temp_files) > 1:
-        print("Joining the files: {}".format(", ".join(temp_files)))
-        completed = subprocess.run(["./aigprod"] + temp_files,
+    if len(hard_tasks) > 1:
+        print("Joining the {} task AIGs".format(len(hard_tasks)))
+        completed = subprocess.run(["./aigprod", "--concat",
+                                    "--map", map_name],
+                                   input=b"".join(components),
                                    stdout=subprocess.PIPE,
                                    stderr=subprocess.PIPE)
         if completed.returncode != 0:
@@ -122,14 +168,20 @@ def encode(file_name):
             return completed.returncode
     else:
         print("Skipped joining step because it's a single task")
-    f = open("tasks.aag", "wb")
+    f = open(out_name, "wb")
     f.write(completed.stdout)
     f.close()
 
 
 def main():
-    if len(sys.argv) != 2:
+    if len(sys.argv) == 3 and sys.argv[1] == "--estimate":
+        exit(estimate(sys.argv[2].strip()))
+    elif len(sys.argv) == 4 and sys.argv[1] == "--map":
+        exit(encode(sys.argv[3].strip(), map_name=sys.argv[2]))
+    elif len(sys.argv) != 2:
         print("Expected a task-system file name as unique argument")
+        print("(optionally preceded by --estimate, or by --map FILE to")
+        print("write the map of the product to FILE instead of tasks.map)")
         exit(1)
     else:
         file_name = sys.argv[1]
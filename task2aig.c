@@ -20,14 +20,107 @@
  *************************************************************************/
 
 #include <assert.h>
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "aiger/aiger.h"
+#include "aigcnf.h"
+
+/* Optional profiling: wall-clock timers for the phases of an encoding and
+ * allocation counters for the gate table and the aiger structure, the
+ * report is only written if enabled with --profile
+ */
+#define MAX_PHASES 16
+
+typedef struct {
+    const char* name;
+    double seconds;
+} Phase;
+
+static struct {
+    bool enabled;
+    const char* path;  // NULL for stderr
+    Phase phases[MAX_PHASES];
+    int noPhases;
+    size_t curBytes;
+    size_t peakBytes;
+} profile;
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline double phaseStart() {
+    return profile.enabled ? now() : 0.0;
+}
+
+static void phaseEnd(const char* name, double start) {
+    if (!profile.enabled || profile.noPhases == MAX_PHASES)
+        return;
+    profile.phases[profile.noPhases].name = name;
+    profile.phases[profile.noPhases].seconds = now() - start;
+    profile.noPhases++;
+}
+
+static inline void countAlloc(size_t bytes) {
+    profile.curBytes += bytes;
+    if (profile.curBytes > profile.peakBytes)
+        profile.peakBytes = profile.curBytes;
+}
+
+static inline void countFree(size_t bytes) {
+    profile.curBytes -= bytes;
+}
+
+static void* profMalloc(void* state, size_t bytes) {
+    (void) state;
+    countAlloc(bytes);
+    return malloc(bytes);
+}
+
+static void profFree(void* state, void* ptr, size_t bytes) {
+    (void) state;
+    countFree(bytes);
+    free(ptr);
+}
+
+/* The file is only opened here, when the report is complete, so that no
+ * empty file is left behind if we stop early
+ * Returns false if the file cannot be written
+ */
+static bool printProfile() {
+    FILE* out = stderr;
+    if (profile.path != NULL) {
+        out = fopen(profile.path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "Cannot write profile: %s\n", profile.path);
+            return false;
+        }
+    }
+    double total = 0.0;
+    for (int i = 0; i < profile.noPhases; i++) {
+        fprintf(out, "phase %s %.6f\n", profile.phases[i].name,
+                profile.phases[i].seconds);
+        total += profile.phases[i].seconds;
+    }
+    fprintf(out, "total_seconds %.6f\n", total);
+    fprintf(out, "peak_bytes %zu\n", profile.peakBytes);
+    if (out != stderr && fclose(out) != 0) {
+        fprintf(stderr, "Cannot write profile: %s\n", profile.path);
+        return false;
+    }
+    return true;
+}
 
 /* A red-black tree to keep track of all and gates
  * we create for the transition function
@@ -98,6 +191,7 @@ static void deleteTree(RBTree* n) {
         return;
     deleteTree(n->left);
     deleteTree(n->right);
+    countFree(sizeof(RBTree));
     free(n);
 }
 
@@ -247,6 +341,7 @@ static void repairRBTree(RBTree* n) {
 static RBTree* insertNode(RBTree* root, int op1, int op2, int freshVar) {
     RBTree* n;
     n = malloc(sizeof(RBTree));
+    countAlloc(sizeof(RBTree));
     if (abs(op1) <= abs(op2)) {
         n->opLeft = op1;
         n->opRight = op2;
@@ -262,6 +357,7 @@ static RBTree* insertNode(RBTree* root, int op1, int op2, int freshVar) {
     // in that case m is the node in the tree with the
     // same key but different variable
     if (m->var != n->var) {
+        countFree(sizeof(RBTree));
         free(n);
         return m;
     }
@@ -310,10 +406,18 @@ static inline int getBin(AigTable* table, int n, int start, int end) {
     return ret;
 }
 
+/* The number of bits needed to encode n in binary, that is floor(lg(n)) + 1,
+ * where lg is the logarithm base 2; but C only has natural logarithms
+ */
+static inline int noBits(int n) {
+    return (int) (log(n) / log(2.0)) + 1;
+}
+
 /* Encode the single-task system in and-inverter
- * graphs, then use A. Biere's AIGER to dump the graph
+ * graphs, then use A. Biere's AIGER to build the graph
+ * NOTE: the caller owns the returned structure
  */
-void encodeTask(int notasks, int index, int deadline, int init,
+aiger* encodeTask(int notasks, int index, int deadline, int init,
                 int noExecTimes, int* exectimes,
                 int noArrivalTimes, int* arrivaltimes) {
 #ifndef NDEBUG
@@ -339,29 +443,30 @@ void encodeTask(int notasks, int index, int deadline, int init,
     // We need to reserve a few variables though
     // (1) one per controllable input + 2 uncontrollable inputs
     // (2) one per latch needed for the counters + 2 helpers
-    // we need floor(lg(notasks)) + 1 just for controllable inputs,
-    // where lg is the logarithm base 2; but C only has
-    // natural logarithms
-    int noInputs = (int) (log(notasks) / log(2.0)) + 1;
+    // we need floor(lg(notasks)) + 1 just for controllable inputs
+    int noInputs = noBits(notasks);
     noInputs += 2;  // uncontrollable inputs
     andGates.nextVar += noInputs;
     // we will also have 2 counters encoded in binary and 2 helper latches
-    int noExecLatches = (int) (log(exectimes[noExecTimes - 1]) / log(2.0)) + 1;
-    int noArrivalLatches = (int) (log(arrivaltimes[noArrivalTimes - 1]) / log(2.0)) + 1;
+    int noExecLatches = noBits(exectimes[noExecTimes - 1]);
+    int noArrivalLatches = noBits(arrivaltimes[noArrivalTimes - 1]);
     int noLatches = noExecLatches + noArrivalLatches + 2;
     andGates.nextVar += noLatches;
     // we will be using all counter latches for the initialization countdown
-    assert((int) (log(init) / log(2.0)) + 1 <= noLatches);
+    assert(noBits(init) <= noLatches);
 #ifndef NDEBUG
     fprintf(stderr, "Reserved %d inputs\n", noInputs);
     fprintf(stderr, "Reserved %d latches\n", noLatches);
 #endif
 
     // Step 1: set up choice decoder
+    double start = phaseStart();
     int taskScheduled = getBin(&andGates, index, 2, 2 + noInputs - 2);
+    phaseEnd("choice_decoder", start);
 
     // Step 2: set up initialization counter and logic for initialization
     // latch
+    start = phaseStart();
     // 2.1 counter logic before initialization
     int latchFunction[noLatches - 2];
     for (int i = 0; i < noLatches - 2; i++) {
@@ -399,12 +504,14 @@ void encodeTask(int notasks, int index, int deadline, int init,
     // 2.3: we update pre-init counter logic to guard the updated with this
     for (int i = 0; i < noLatches - 2; i++)
         latchFunction[i] = and(&andGates, latchFunction[i], isInitialized * -1);
+    phaseEnd("init_counter", start);
 
     // Step 3: Arrival time counter logic
     // we set the bit to 1 if it is 0, all less significant bits are 1, the
     // tick_tock clock is set to 1; or if it is 1 and
     // either the tick_tock clock is 0 or some less significant bit is not 1
     // NOTE: this is all guarded by initialization and non-arrival
+    start = phaseStart();
     int canArrive = -1;
     for (int i = 0; i < noArrivalTimes - 1; i++) {
         int arrivalAllowed = getBin(&andGates, arrivaltimes[i] - 1,
@@ -433,6 +540,7 @@ void encodeTask(int notasks, int index, int deadline, int init,
                                   or(&andGates, flip, keep)));
         rollingLSB = and(&andGates, rollingLSB, latchvar);
     }
+    phaseEnd("arrival_counter", start);
 
     // Step 4: Execution time counter logic
     // we set the bit to 1 if it is 0, all less significant bits are 1, the
@@ -442,6 +550,7 @@ void encodeTask(int notasks, int index, int deadline, int init,
     // execution terminates
     // NOTE: this is all guarded by initialization and non-arrival
     // and non-termination
+    start = phaseStart();
     int canTerminate = -1;
     for (int i = 0; i < noExecTimes - 1; i++) {
         int termAllowed = getBin(&andGates, exectimes[i],
@@ -478,21 +587,29 @@ void encodeTask(int notasks, int index, int deadline, int init,
                                      or(&andGates, flip, keep))));
         rollingLSB = and(&andGates, rollingLSB, latchvar);
     }
+    phaseEnd("exec_counter", start);
 
     // Step 5: Deadline check with execution timer
+    start = phaseStart();
     mask = 1;
     int atDeadline = getBin(&andGates, deadline,
                             2 + noInputs + noExecLatches,
                             2 + noInputs + noExecLatches + noArrivalLatches);
     int unsafe = and(&andGates, atDeadline, allset * -1);
     unsafe = and(&andGates, unsafe, ticktockLatch);
+    phaseEnd("deadline_check", start);
 
 #ifndef NDEBUG
     recursivePrint(andGates.root, 0);
 #endif
 
-    // Step 6: Create and print the constructed AIG
-    aiger* aig = aiger_init();
+    // Step 6: Create the constructed AIG
+    aiger* aig = aiger_init_mem(NULL, profMalloc, profFree);
+    // all sizes are known by now, the variables of the and gates are
+    // the ones after the inputs and latches
+    aiger_reserve(aig, noInputs, noLatches,
+                  andGates.nextVar - 2 - noInputs - noLatches,
+                  andGates.nextVar - 2);
 
     // add inputs
     int lit = 2;
@@ -529,26 +646,80 @@ void encodeTask(int notasks, int index, int deadline, int init,
 #ifndef NDEBUG
     fprintf(stderr, "Dumping AND-gates into aiger structure\n");
 #endif
+    start = phaseStart();
     dumpAiger(andGates.root, aig);
+    phaseEnd("dump_aiger", start);
 
     // add bad state
     aiger_add_output(aig, var2aiglit(unsafe), "missed_deadline");
 
+    // check it in debug mode, or to time it when profiling
 #ifndef NDEBUG
     fprintf(stderr, "AIG structure created, now checking it!\n");
-    const char* msg = aiger_check(aig);
-    if (msg) {
-        fprintf(stderr, "%s\n", msg);
-    }
+    bool check = true;
+#else
+    bool check = profile.enabled;
 #endif
-
-    // and dump the aig
-    aiger_write_to_file(aig, aiger_ascii_mode, stdout);
+    if (check) {
+        start = phaseStart();
+        const char* msg = aiger_check(aig);
+        phaseEnd("aiger_check", start);
+        if (msg) {
+            fprintf(stderr, "%s\n", msg);
+        }
+    }
 
     // Free dynamic memory
-    aiger_reset(aig);
     deleteTree(andGates.root);
-    return;
+    return aig;
+}
+
+/* Estimate the size of the AIG encodeTask would build, from the parameters
+ * alone, and print it to stdout as "KEY VALUE" lines
+ * The number of and gates is an upper bound: it counts every call to and()
+ * and or() made by encodeTask, before structural hashing merges any of
+ * them. If bound is non-negative we also estimate the CNF for -k bound.
+ */
+static void estimateTask(int notasks, int init,
+                         int noExecTimes, int maxexec,
+                         int noArrivalTimes, int maxarrival, int bound) {
+    // the same variables encodeTask reserves
+    int noInputs = noBits(notasks) + 2;
+    int noExecLatches = noBits(maxexec);
+    int noArrivalLatches = noBits(maxarrival);
+    int noLatches = noExecLatches + noArrivalLatches + 2;
+    const long E = noExecLatches;
+    const long R = noArrivalLatches;
+    const long N = E + R;
+
+    // Step 1: choice decoder
+    long noAnds = noInputs - 2;
+    // Step 2: initialization counter, latch, and guards
+    noAnds += 7 * N + (N + 1) + N;
+    // Step 3: arrival time counter
+    noAnds += (noArrivalTimes - 1) * (R + 1) + R + 4 + 8 * R;
+    // Step 4: execution time counter
+    noAnds += (noExecTimes - 1) * (E + 1) + E + 3 + (E + 1) + 11 * E;
+    // Step 5: deadline check
+    noAnds += R + 2;
+
+    printf("inputs %d\n", noInputs);
+    printf("latches %d\n", noLatches);
+    printf("outputs 1\n");
+    printf("ands_max %ld\n", noAnds);
+    printf("maxvar_max %ld\n", noInputs + noLatches + noAnds);
+    // the full latch space and the configurations we expect to reach:
+    // pairs of counter values for both phases of the tick_tock clock, plus
+    // the initialization countdown
+    printf("state_bits %d\n", noLatches);
+    printf("reachable_states_est %ld\n",
+           2L * (maxexec + 1) * (maxarrival + 1) + 2L * init);
+    if (bound >= 0) {
+        // one copy of all inputs and gates per time frame, see aigcnf.h
+        printf("cnf_vars_max %ld\n",
+               1 + (noInputs + noAnds) * (bound + 1L));
+        printf("cnf_clauses_max %ld\n", 3 * noAnds * (bound + 1L) + 2);
+    }
 }
 
 static void printHelp() {
@@ -561,24 +732,151 @@ static void printHelp() {
     fprintf(stderr, "  -h    print this message\n");
     fprintf(stderr, "  -e    possible execution time, multiple allowed\n");
     fprintf(stderr, "  -a    possible arrival time, multiple allowed\n");
+    fprintf(stderr, "        (-e and -a also accept ranges LO-HI[:STEP] and "
+                    "@FILE lists)\n");
+    fprintf(stderr, "  -k    unrolling bound for --cnf\n");
+    fprintf(stderr, "  --cnf write a DIMACS CNF, satisfiable iff the "
+                    "deadline can be\n"
+                    "        missed within k steps, instead of the AIG\n");
+    fprintf(stderr, "  --estimate\n"
+                    "        print the estimated size of the AIG (and of the "
+                    "CNF with -k)\n"
+                    "        without building it\n");
+    fprintf(stderr, "  --profile[=FILE]\n"
+                    "        report the time of each phase and the peak "
+                    "memory to FILE\n"
+                    "        (stderr by default)\n");
     return;
 }
 
-typedef struct SLIntList {
-    int val;
-    struct SLIntList* next;
-} SLIntList;
+/* A growable array of time values, sorted and deduplicated once all
+ * options have been read
+ */
+typedef struct {
+    int* vals;
+    int size;
+    int capacity;
+} IntArray;
+
+static void pushInt(IntArray* arr, int x) {
+    if (arr->size == arr->capacity) {
+        arr->capacity = arr->capacity ? 2 * arr->capacity : 16;
+        arr->vals = realloc(arr->vals, arr->capacity * sizeof(int));
+    }
+    arr->vals[arr->size++] = x;
+}
+
+static int cmpInt(const void* a, const void* b) {
+    int x = *((const int*) a);
+    int y = *((const int*) b);
+    return (x > y) - (x < y);
+}
 
-void deleteSLIntList(SLIntList* item) {
-    while (item != NULL) {
-        SLIntList* temp = item->next;
-        free(item);
-        item = temp;
+static void sortAndDedup(IntArray* arr) {
+    if (arr->size == 0)
+        return;
+    qsort(arr->vals, arr->size, sizeof(int), cmpInt);
+    int j = 1;
+    for (int i = 1; i < arr->size; i++) {
+        if (arr->vals[i] != arr->vals[j - 1])
+            arr->vals[j++] = arr->vals[i];
     }
-    return;
+    arr->size = j;
+}
+
+/* Parse the unrolling bound of -k, a non-negative int without trailing
+ * characters
+ */
+static bool parseBound(const char* str, int* bound) {
+    char* end;
+    errno = 0;
+    long k = strtol(str, &end, 10);
+    if (end == str || *end != '\0' || errno == ERANGE || k < 0
+            || k > INT_MAX)
+        return false;
+    *bound = (int) k;
+    return true;
+}
+
+/* At most this many time values per list, more would not fit an AIG of
+ * any practical size anyway
+ */
+#define MAX_TIMES (1 << 16)
+
+/* Parse a time value in [0, INT_MAX] at the start of str
+ */
+static bool parseTime(const char* str, char** end, long* value) {
+    errno = 0;
+    *value = strtol(str, end, 10);
+    return *end != str && errno != ERANGE && *value >= 0
+        && *value <= INT_MAX;
+}
+
+/* Parse a single time value N or a range LO-HI, optionally with a step
+ * as in LO-HI:STEP, and add all its values to arr
+ */
+static bool parseTimes(IntArray* arr, const char* str) {
+    char* end;
+    long lo;
+    if (!parseTime(str, &end, &lo))
+        return false;
+    if (*end == '\0') {
+        if (arr->size == MAX_TIMES)
+            return false;
+        pushInt(arr, (int) lo);
+        return true;
+    }
+    if (*end != '-')
+        return false;
+    long hi;
+    if (!parseTime(end + 1, &end, &hi))
+        return false;
+    long step = 1;
+    if (*end == ':' && !parseTime(end + 1, &end, &step))
+        return false;
+    if (*end != '\0' || lo > hi || step <= 0
+            || (hi - lo) / step >= MAX_TIMES - arr->size)
+        return false;
+    // stop before x + step could overflow
+    for (long x = lo; ; x += step) {
+        pushInt(arr, (int) x);
+        if (hi - x < step)
+            break;
+    }
+    return true;
+}
+
+/* Add the times given as an option argument, which is either a value or
+ * a range (see parseTimes) or @FILE for a file with whitespace-separated
+ * values and ranges
+ */
+static bool addTimes(IntArray* arr, const char* arg) {
+    if (arg[0] != '@') {
+        if (!parseTimes(arr, arg)) {
+            fprintf(stderr, "Invalid time or range: %s\n", arg);
+            return false;
+        }
+        return true;
+    }
+    FILE* file = fopen(arg + 1, "r");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot read time list: %s\n", arg + 1);
+        return false;
+    }
+    char token[64];
+    bool ok = true;
+    while (ok && fscanf(file, "%63s", token) == 1) {
+        ok = parseTimes(arr, token);
+        if (!ok)
+            fprintf(stderr, "%s: invalid time or range: %s\n",
+                    arg + 1, token);
+    }
+    fclose(file);
+    return ok;
 }
 
 int main(int argc, char* argv[]) {
+    double start = now();
     int c;
     int notasks;
     int index;
@@ -586,74 +884,84 @@ int main(int argc, char* argv[]) {
     int init;
     int maxexec;
     int maxarrival;
-    SLIntList* execTimes = NULL;
-    SLIntList* arrivalTimes = NULL;
-    int noExecTimes = 1;
-    int noArrivalTimes = 1;
-    int x;
-    while ((c = getopt(argc, argv, "he:a:")) != -1) {
+    IntArray execTimes = {NULL, 0, 0};
+    IntArray arrivalTimes = {NULL, 0, 0};
+    int bound = -1;
+    int cnf = 0;
+    int estimate = 0;
+    static struct option longOptions[] = {
+        {"cnf", no_argument, NULL, 'c'},
+        {"estimate", no_argument, NULL, 's'},
+        {"profile", optional_argument, NULL, 'p'},
+        {NULL, 0, NULL, 0}
+    };
+    while ((c = getopt_long(argc, argv, "he:a:k:", longOptions, NULL)) != -1) {
         switch (c) {
+            case 'c':
+                cnf = 1;
+                break;
+            case 's':
+                estimate = 1;
+                break;
+            case 'p':
+                // the last one wins, the file is opened by printProfile
+                profile.enabled = true;
+                profile.path = optarg;
+                break;
+            case 'k':
+                if (!parseBound(optarg, &bound)) {
+                    fprintf(stderr, "Invalid bound: %s\n", optarg);
+                    // get rid of dynamic memory and exit
+                    free(execTimes.vals);
+                    free(arrivalTimes.vals);
+                    return EXIT_FAILURE;
+                }
+                break;
             case 'h':
                 printHelp();
                 break;
             case 'e':
-                x = atoi(optarg);
-                if (execTimes == NULL || execTimes->val > x) {
-                    SLIntList* temp = execTimes;
-                    execTimes = malloc(sizeof(SLIntList));
-                    execTimes->next = temp;
-                    execTimes->val = atoi(optarg);
-                    noExecTimes++;
-                } else {
-                    SLIntList* item = execTimes;
-                    while (item->next != NULL && item->next->val <= x)
-                        item = item->next;
-                    if (item->val < x) {
-                        SLIntList* temp = item->next;
-                        item->next = malloc(sizeof(SLIntList));
-                        item->next->val = x;
-                        item->next->next = temp;
-                        noExecTimes++;
-                    }
+                if (!addTimes(&execTimes, optarg)) {
+                    // get rid of dynamic memory and exit
+                    free(execTimes.vals);
+                    free(arrivalTimes.vals);
+                    return EXIT_FAILURE;
                 }
                 break;
             case 'a':
-                x = atoi(optarg);
-                if (arrivalTimes == NULL || arrivalTimes->val > x) {
-                    SLIntList* temp = arrivalTimes;
-                    arrivalTimes = malloc(sizeof(SLIntList));
-                    arrivalTimes->next = temp;
-                    arrivalTimes->val = atoi(optarg);
-                    noArrivalTimes++;
-                } else {
-                    SLIntList* item = arrivalTimes;
-                    while (item->next != NULL && item->next->val <= x)
-                        item = item->next;
-                    if (item->val < x) {
-                        SLIntList* temp = item->next;
-                        item->next = malloc(sizeof(SLIntList));
-                        item->next->val = x;
-                        item->next->next = temp;
-                        noArrivalTimes++;
-                    }
+                if (!addTimes(&arrivalTimes, optarg)) {
+                    // get rid of dynamic memory and exit
+                    free(execTimes.vals);
+                    free(arrivalTimes.vals);
+                    return EXIT_FAILURE;
                 }
                 break;
             case '?':  // getopt found an invalid option
                 // get rid of dynamic memory and exit
-                deleteSLIntList(execTimes);
-                deleteSLIntList(arrivalTimes);
+                free(execTimes.vals);
+                free(arrivalTimes.vals);
                 return EXIT_FAILURE;
             default:
                 assert(false);  // this should not be reachable
         }
     }
 
+    // the unrolling bound and the CNF mode only make sense together,
+    // though the estimate may also look at the CNF
+    if (cnf != (bound >= 0) && !estimate) {
+        fprintf(stderr, "Expected both -k K and --cnf, or neither!\n");
+        // get rid of dynamic memory and exit
+        free(execTimes.vals);
+        free(arrivalTimes.vals);
+        return EXIT_FAILURE;
+    }
+
     // making sure we have precisely 6 non-options
     if (argc - optind != 6) {
         fprintf(stderr, "Expected 6 positional arguments!\n");
         // get rid of dynamic memory and exit
-        deleteSLIntList(execTimes);
-        deleteSLIntList(arrivalTimes);
+        free(execTimes.vals);
+        free(arrivalTimes.vals);
         return EXIT_FAILURE;
     } else {
         notasks = atoi(argv[optind++]);
@@ -664,31 +972,47 @@ int main(int argc, char* argv[]) {
         maxarrival = atoi(argv[optind++]);
     }
 
-    // create arrays for time lists
-    int execarray[noExecTimes];
-    SLIntList* item = execTimes;
-    for (int i = 0; i < noExecTimes - 1; i++) {
-        assert(item != NULL);
-        execarray[i] = item->val;
-        item = item->next;
-    }
-    execarray[noExecTimes - 1] = maxexec;
-    int arrivalarray[noArrivalTimes];
-    item = arrivalTimes;
-    for (int i = 0; i < noArrivalTimes - 1; i++) {
-        assert(item != NULL);
-        arrivalarray[i] = item->val;
-        item = item->next;
+    // sort the time lists once and append the maximal times
+    sortAndDedup(&execTimes);
+    pushInt(&execTimes, maxexec);
+    sortAndDedup(&arrivalTimes);
+    pushInt(&arrivalTimes, maxarrival);
+    phaseEnd("args", start);
+
+    if (estimate) {
+        start = phaseStart();
+        estimateTask(notasks, init, execTimes.size, maxexec,
+                     arrivalTimes.size, maxarrival, bound);
+        phaseEnd("estimate", start);
+        free(execTimes.vals);
+        free(arrivalTimes.vals);
+        if (profile.enabled && !printProfile())
+            return EXIT_FAILURE;
+        return EXIT_SUCCESS;
     }
-    arrivalarray[noArrivalTimes - 1] = maxarrival;
-
-    // get rid of dynamic memory
-    deleteSLIntList(execTimes);
-    deleteSLIntList(arrivalTimes);
 
     // encode the task as an and-inverter graph
-    encodeTask(notasks, index, deadline, init,
-               noExecTimes, execarray, noArrivalTimes, arrivalarray);
+    aiger* aig = encodeTask(notasks, index, deadline, init,
+                            execTimes.size, execTimes.vals,
+                            arrivalTimes.size, arrivalTimes.vals);
+    free(execTimes.vals);
+    free(arrivalTimes.vals);
+
+    // and dump the aig, or its unrolling
+    int ok;
+    start = phaseStart();
+    if (cnf)
+        ok = writeUnrolledCnf(aig, bound, stdout);
+    else
+        ok = aiger_write_to_file(aig, aiger_ascii_mode, stdout);
+    fflush(stdout);
+    phaseEnd("write", start);
+    aiger_reset(aig);
+    bool profiled = !profile.enabled || printProfile();
+    if (!ok) {
+        fprintf(stderr, "Writing error!\n");
+        return EXIT_FAILURE;
+    }
 
-    return EXIT_SUCCESS;
+    return profiled ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,303 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+/* Test for the unrolled CNF of aigcnf.c: for every assignment of its free
+ * variables (the inputs in every frame and the uninitialized latches in
+ * frame 0), unit propagation through the Tseitin clauses must give the
+ * latch values of a simulation of the AIG on the same run, and the CNF is
+ * satisfied if and only if the simulation reaches an output (or bad-state
+ * literal) within the bound. Reads the AIG from the standard input.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aiger/aiger.h"
+#include "../aigcnf.h"
+
+// the free variables are enumerated, so there must not be too many
+#define MAX_FREE 24
+
+typedef struct {
+    unsigned bound;
+    // the map of the header comments: CNF literals of the inputs and the
+    // latches of every frame, frame by frame
+    int* inputLits;
+    int* latchLits;
+    unsigned noInputLits;
+    unsigned noLatchLits;
+    // the clauses, each terminated by 0
+    int noVars;
+    int* lits;
+    size_t noLits;
+} Cnf;
+
+static bool readCnf(Cnf* cnf, const aiger* aig, FILE* file) {
+    unsigned frames = cnf->bound + 1;
+    cnf->inputLits = malloc((aig->num_inputs * frames + 1) * sizeof(int));
+    cnf->latchLits = malloc((aig->num_latches * frames + 1) * sizeof(int));
+    cnf->noInputLits = cnf->noLatchLits = 0;
+    cnf->lits = NULL;
+    char line[256];
+    unsigned frame;
+    int lit;
+    unsigned noClauses = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "c input %u %d", &frame, &lit) == 2) {
+            if (cnf->noInputLits == aig->num_inputs * frames)
+                return false;
+            cnf->inputLits[cnf->noInputLits++] = lit;
+        } else if (sscanf(line, "c latch %u %d", &frame, &lit) == 2) {
+            if (cnf->noLatchLits == aig->num_latches * frames)
+                return false;
+            cnf->latchLits[cnf->noLatchLits++] = lit;
+        } else if (sscanf(line, "p cnf %d %u", &cnf->noVars,
+                          &noClauses) == 2) {
+            break;
+        }
+    }
+    if (cnf->noInputLits != aig->num_inputs * frames
+            || cnf->noLatchLits != aig->num_latches * frames
+            || noClauses == 0)
+        return false;
+    size_t capLits = 1024;
+    cnf->lits = malloc(capLits * sizeof(int));
+    cnf->noLits = 0;
+    unsigned read = 0;
+    while (read < noClauses && fscanf(file, "%d", &lit) == 1) {
+        if (lit > cnf->noVars || -lit > cnf->noVars)
+            return false;
+        if (cnf->noLits == capLits) {
+            capLits *= 2;
+            cnf->lits = realloc(cnf->lits, capLits * sizeof(int));
+        }
+        cnf->lits[cnf->noLits++] = lit;
+        if (lit == 0)
+            read++;
+    }
+    return read == noClauses;
+}
+
+// values are 1 (true), -1 (false) or 0 (unassigned)
+static inline int litValue(const int* vals, int lit) {
+    return lit > 0 ? vals[lit] : -vals[-lit];
+}
+
+/* Unit propagation through all clauses but the last one, which is the
+ * property; returns false on a conflict
+ */
+static bool propagate(const Cnf* cnf, int* vals, size_t last) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        size_t start = 0;
+        while (start < last) {
+            size_t end = start;
+            int unassigned = 0;
+            unsigned noUnassigned = 0;
+            bool satisfied = false;
+            for (; cnf->lits[end] != 0; end++) {
+                int value = litValue(vals, cnf->lits[end]);
+                if (value > 0)
+                    satisfied = true;
+                else if (value == 0) {
+                    unassigned = cnf->lits[end];
+                    noUnassigned++;
+                }
+            }
+            if (!satisfied && noUnassigned == 0)
+                return false;
+            if (!satisfied && noUnassigned == 1) {
+                vals[abs(unassigned)] = unassigned > 0 ? 1 : -1;
+                changed = true;
+            }
+            start = end + 1;
+        }
+    }
+    return true;
+}
+
+static bool satisfied(const Cnf* cnf, const int* vals, size_t start) {
+    for (; start < cnf->noLits; start++) {
+        if (litValue(vals, cnf->lits[start]) > 0) {
+            while (cnf->lits[start] != 0)
+                start++;
+        } else if (cnf->lits[start] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool simValue(const bool* sim, unsigned lit) {
+    return sim[aiger_lit2var(lit)] != aiger_sign(lit);
+}
+
+/* Simulate the run given by the CNF values of the free variables and
+ * compare the latch values with the CNF; returns whether an output or
+ * bad-state literal is true in some frame, or -1 on a mismatch
+ */
+static int simulate(const aiger* aig, const Cnf* cnf, const int* vals,
+                    bool* sim, bool* state) {
+    bool hit = false;
+    sim[0] = false;
+    for (unsigned i = 0; i < aig->num_latches; i++) {
+        unsigned reset = aig->latches[i].reset;
+        if (reset == aiger_false || reset == aiger_true)
+            state[i] = reset == aiger_true;
+        else
+            state[i] = litValue(vals, cnf->latchLits[i]) > 0;
+    }
+    for (unsigned frame = 0; frame <= cnf->bound; frame++) {
+        for (unsigned i = 0; i < aig->num_inputs; i++) {
+            int lit = cnf->inputLits[frame * aig->num_inputs + i];
+            sim[aiger_lit2var(aig->inputs[i].lit)] = litValue(vals, lit) > 0;
+        }
+        for (unsigned i = 0; i < aig->num_latches; i++) {
+            int lit = cnf->latchLits[frame * aig->num_latches + i];
+            if ((litValue(vals, lit) > 0) != state[i]) {
+                fprintf(stderr, "cnfsim: latch %u differs in frame %u\n",
+                        i, frame);
+                return -1;
+            }
+            sim[aiger_lit2var(aig->latches[i].lit)] = state[i];
+        }
+        for (unsigned i = 0; i < aig->num_ands; i++) {
+            aiger_and* gate = aig->ands + i;
+            sim[aiger_lit2var(gate->lhs)] = simValue(sim, gate->rhs0)
+                                            && simValue(sim, gate->rhs1);
+        }
+        for (unsigned i = 0; i < aig->num_outputs; i++)
+            hit |= simValue(sim, aig->outputs[i].lit);
+        for (unsigned i = 0; i < aig->num_bad; i++)
+            hit |= simValue(sim, aig->bad[i].lit);
+        for (unsigned i = 0; i < aig->num_latches; i++)
+            state[i] = simValue(sim, aig->latches[i].next);
+    }
+    return hit;
+}
+
+static int check(aiger* aig, Cnf* cnf, FILE* file) {
+    // the CNF reencodes the AIG, which we then simulate
+    if (!writeUnrolledCnf(aig, cnf->bound, file)) {
+        fprintf(stderr, "cnfsim: cannot write the CNF\n");
+        return 1;
+    }
+    rewind(file);
+    if (!readCnf(cnf, aig, file)) {
+        fprintf(stderr, "cnfsim: cannot parse the CNF\n");
+        return 1;
+    }
+    // the free variables and where the property clause starts
+    int freeVars[MAX_FREE];
+    unsigned noFree = 0;
+    for (unsigned i = 0; i < cnf->noInputLits + aig->num_latches; i++) {
+        int lit = i < cnf->noInputLits ? cnf->inputLits[i]
+                                       : cnf->latchLits[i - cnf->noInputLits];
+        if (abs(lit) == 1)
+            continue;
+        if (noFree == MAX_FREE) {
+            fprintf(stderr, "cnfsim: too many free variables\n");
+            return 1;
+        }
+        freeVars[noFree++] = abs(lit);
+    }
+    size_t last = cnf->noLits - 1;
+    while (last > 0 && cnf->lits[last - 1] != 0)
+        last--;
+
+    int* vals = malloc((cnf->noVars + 1) * sizeof(int));
+    bool* sim = malloc((aig->maxvar + 1) * sizeof(bool));
+    bool* state = malloc((aig->num_latches + 1) * sizeof(bool));
+    unsigned long runs = 1ul << noFree;
+    unsigned long hits = 0;
+    int failed = 0;
+    for (unsigned long run = 0; !failed && run < runs; run++) {
+        memset(vals, 0, (cnf->noVars + 1) * sizeof(int));
+        vals[1] = 1;
+        for (unsigned i = 0; i < noFree; i++)
+            vals[freeVars[i]] = (run >> i) & 1 ? 1 : -1;
+        if (!propagate(cnf, vals, last)) {
+            fprintf(stderr, "cnfsim: conflict in run %lu\n", run);
+            failed = 1;
+            break;
+        }
+        for (int v = 1; v <= cnf->noVars; v++) {
+            if (vals[v] == 0) {
+                fprintf(stderr, "cnfsim: variable %d is not determined\n",
+                        v);
+                failed = 1;
+                break;
+            }
+        }
+        int hit = failed ? 0 : simulate(aig, cnf, vals, sim, state);
+        if (hit < 0) {
+            failed = 1;
+        } else if (!failed && hit != satisfied(cnf, vals, last)) {
+            fprintf(stderr, "cnfsim: the CNF and the simulation disagree "
+                            "in run %lu\n", run);
+            failed = 1;
+        }
+        hits += hit > 0;
+    }
+    // both kinds of runs should be compared
+    if (!failed && (hits == 0 || hits == runs)) {
+        fprintf(stderr, "cnfsim: %lu of %lu runs reach the property\n",
+                hits, runs);
+        failed = 1;
+    }
+    free(state);
+    free(sim);
+    free(vals);
+    return failed;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: cnfsim BOUND < AIG\n");
+        return 1;
+    }
+    Cnf cnf;
+    cnf.bound = (unsigned) strtoul(argv[1], NULL, 10);
+    aiger* aig = aiger_init();
+    const char* error = aiger_read_from_file(aig, stdin);
+    if (error != NULL) {
+        fprintf(stderr, "cnfsim: %s\n", error);
+        aiger_reset(aig);
+        return 1;
+    }
+    FILE* file = tmpfile();
+    if (file == NULL) {
+        perror("tmpfile");
+        aiger_reset(aig);
+        return 1;
+    }
+    cnf.inputLits = cnf.latchLits = cnf.lits = NULL;
+    int failed = check(aig, &cnf, file);
+    fclose(file);
+    free(cnf.inputLits);
+    free(cnf.latchLits);
+    free(cnf.lits);
+    aiger_reset(aig);
+    return failed;
+}
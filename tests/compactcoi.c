@@ -0,0 +1,140 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+/* Test for aiger_compact_coi: dead latches and gates injected into a small
+ * AIG, also gates which depend on live ones, are removed, the live ones
+ * (including those only reachable from a bad-state literal or through a
+ * latch) are kept, and the outputs and bad-state literals of the compacted
+ * AIG agree with those of the original one in pseudo-random runs.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../aiger/aiger.h"
+
+#define RUNS 64
+#define STEPS 32
+
+// inputs 2 and 4; the output 10 needs the latch 6 and the gate 8, the
+// bad-state literal 18 needs the latch 20 whose next state is input 2;
+// the latch 12 and the gates 14 and 16 are dead
+static aiger* deadLogicAig() {
+    aiger* aig = aiger_init();
+    aiger_add_input(aig, 2, "a");
+    aiger_add_input(aig, 4, "b");
+    aiger_add_latch(aig, 6, 10, "live");
+    aiger_add_latch(aig, 12, 16, "dead");
+    aiger_add_latch(aig, 20, 2, "flag");
+    aiger_add_reset(aig, 20, 1);
+    aiger_add_and(aig, 8, 2, 6);
+    aiger_add_and(aig, 10, 8, 5);
+    aiger_add_and(aig, 14, 12, 4);
+    aiger_add_and(aig, 16, 14, 8);
+    aiger_add_and(aig, 18, 20, 4);
+    aiger_add_output(aig, 10, "o");
+    aiger_add_bad(aig, 18, "f");
+    return aig;
+}
+
+static inline bool simValue(const bool* sim, unsigned lit) {
+    return sim[aiger_lit2var(lit)] != aiger_sign(lit);
+}
+
+// one step from the latch values in state, with the and gates in
+// topological order
+static void step(const aiger* aig, bool* sim, bool* state,
+                 const bool* inputs) {
+    sim[0] = false;
+    for (unsigned i = 0; i < aig->num_inputs; i++)
+        sim[aiger_lit2var(aig->inputs[i].lit)] = inputs[i];
+    for (unsigned i = 0; i < aig->num_latches; i++)
+        sim[aiger_lit2var(aig->latches[i].lit)] = state[i];
+    for (unsigned i = 0; i < aig->num_ands; i++) {
+        aiger_and* gate = aig->ands + i;
+        sim[aiger_lit2var(gate->lhs)] = simValue(sim, gate->rhs0)
+                                        && simValue(sim, gate->rhs1);
+    }
+    for (unsigned i = 0; i < aig->num_latches; i++)
+        state[i] = simValue(sim, aig->latches[i].next);
+}
+
+static void reset(const aiger* aig, bool* state) {
+    for (unsigned i = 0; i < aig->num_latches; i++)
+        state[i] = aig->latches[i].reset == aiger_true;
+}
+
+static bool sameRuns(const aiger* a, const aiger* b) {
+    bool simA[32], stateA[8], simB[32], stateB[8], inputs[2];
+    unsigned seed = 2463534242u;
+    for (int run = 0; run < RUNS; run++) {
+        reset(a, stateA);
+        reset(b, stateB);
+        for (int s = 0; s < STEPS; s++) {
+            for (unsigned i = 0; i < a->num_inputs; i++) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                inputs[i] = seed & 1;
+            }
+            step(a, simA, stateA, inputs);
+            step(b, simB, stateB, inputs);
+            if (simValue(simA, a->outputs[0].lit)
+                    != simValue(simB, b->outputs[0].lit)
+                    || simValue(simA, a->bad[0].lit)
+                    != simValue(simB, b->bad[0].lit))
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(void) {
+    aiger* original = deadLogicAig();
+    aiger* aig = deadLogicAig();
+    aiger_compact_coi(aig);
+    int failed = 0;
+    const char* error = aiger_check(aig);
+    if (error != NULL) {
+        fprintf(stderr, "compactcoi: %s\n", error);
+        failed = 1;
+    } else if (aig->num_inputs != 2 || aig->num_latches != 2
+               || aig->num_ands != 3 || aig->maxvar != 7
+               || aig->num_outputs != 1 || aig->num_bad != 1) {
+        fprintf(stderr, "compactcoi: wrong sizes %u %u %u %u %u %u\n",
+                aig->maxvar, aig->num_inputs, aig->num_latches,
+                aig->num_ands, aig->num_outputs, aig->num_bad);
+        failed = 1;
+    } else if (strcmp(aig->latches[0].name, "live") != 0
+               || strcmp(aig->latches[1].name, "flag") != 0
+               || aig->latches[1].reset != aiger_true) {
+        fprintf(stderr, "compactcoi: wrong latches kept\n");
+        failed = 1;
+    } else if (!sameRuns(original, aig)) {
+        fprintf(stderr, "compactcoi: the compacted AIG behaves "
+                        "differently\n");
+        failed = 1;
+    }
+    aiger_reset(aig);
+    aiger_reset(original);
+    return failed;
+}
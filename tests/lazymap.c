@@ -0,0 +1,127 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+/* Test for mapping a binary AIG with lazy decoding of its AND section: the
+ * header fields are right before decoding, decoding gives back the ANDs,
+ * and a corrupted AND section is reported (also by the functions which
+ * decode implicitly) instead of leaving an AIG without ANDs.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../aiger/aiger.h"
+
+// inputs 2 and 4, latch 6 with next state 10, output 12
+static aiger* smallAig() {
+    aiger* aig = aiger_init();
+    aiger_add_input(aig, 2, "a");
+    aiger_add_input(aig, 4, "b");
+    aiger_add_latch(aig, 6, 10, "l");
+    aiger_add_and(aig, 8, 2, 4);
+    aiger_add_and(aig, 10, 9, 6);
+    aiger_add_and(aig, 12, 10, 3);
+    aiger_add_output(aig, 12, "o");
+    return aig;
+}
+
+static bool writeFile(const char* path, const char* bytes, size_t size) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL)
+        return false;
+    bool ok = fwrite(bytes, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+}
+
+static int fail(const char* msg) {
+    fprintf(stderr, "lazymap: %s\n", msg);
+    return 1;
+}
+
+int main(void) {
+    char path[] = "/tmp/lazymapXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return fail("cannot create a temporary file");
+    close(fd);
+
+    aiger* aig = smallAig();
+    char bytes[256];
+    if (!aiger_write_to_string(aig, aiger_binary_mode, bytes, sizeof(bytes)))
+        return fail("cannot write the AIG");
+    size_t size = strlen(bytes);
+    int failed = 0;
+
+    // the intact file
+    aiger* lazy = aiger_init();
+    if (!writeFile(path, bytes, size)
+            || aiger_open_and_map(lazy, path, 1) != NULL) {
+        failed = fail("cannot map the AIG");
+    } else if (lazy->maxvar != 6 || lazy->num_inputs != 2
+               || lazy->num_latches != 1 || lazy->num_outputs != 1
+               || lazy->num_ands != 0) {
+        failed = fail("wrong header fields before decoding");
+    } else if (aiger_decode_ands(lazy) != NULL || lazy->num_ands != 3) {
+        failed = fail("cannot decode the ANDs");
+    } else {
+        for (unsigned i = 0; i < 3; i++) {
+            if (lazy->ands[i].lhs != aig->ands[i].lhs
+                    || lazy->ands[i].rhs0 != aig->ands[i].rhs0
+                    || lazy->ands[i].rhs1 != aig->ands[i].rhs1)
+                failed = fail("wrong AND after decoding");
+        }
+    }
+    aiger_reset(lazy);
+
+    // the first delta of the first AND, after the header, latch and
+    // output lines, is made larger than its left-hand side
+    char* p = bytes;
+    for (int lines = 0; lines < 3; p++)
+        lines += *p == '\n';
+    *p = 0x7f;
+    lazy = aiger_init();
+    if (!writeFile(path, bytes, size)
+            || aiger_open_and_map(lazy, path, 1) != NULL) {
+        failed = fail("cannot map the corrupted AIG");
+    } else if (aiger_coi(lazy) != NULL) {
+        failed = fail("cone of influence of a corrupted AIG");
+    } else if (aiger_is_reencoded(lazy)) {
+        failed = fail("a corrupted AIG is reencoded");
+    } else if (aiger_is_and(lazy, 8) != NULL) {
+        failed = fail("an AND of a corrupted AIG");
+    } else if (aiger_decode_ands(lazy) == NULL
+               || strstr(aiger_error(lazy), "invalid delta") == NULL) {
+        failed = fail("corrupted AND section not reported");
+    } else {
+        unsigned ands = lazy->num_ands;
+        aiger_add_and(lazy, 14, 2, 4);
+        if (lazy->num_ands != ands)
+            failed = fail("an AND was added to a corrupted AIG");
+    }
+    aiger_reset(lazy);
+
+    aiger_reset(aig);
+    unlink(path);
+    return failed;
+}
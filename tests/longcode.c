@@ -0,0 +1,68 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+/* Regression test for reading a binary AIG which ends right after two
+ * deltas written with the longest (6 byte) code. The buffer is placed
+ * right before an inaccessible page so that reading past its end crashes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../aiger/aiger.h"
+
+static const unsigned char longCodes[] = {
+    'a', 'i', 'g', ' ', '1', ' ', '0', ' ', '0', ' ', '0', ' ', '1', '\n',
+    // deltas 2 and 0 for the and gate 2 = 0 & 0
+    0x82, 0x80, 0x80, 0x80, 0x80, 0x00,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x00
+};
+
+int main(void) {
+    long pageSize = sysconf(_SC_PAGESIZE);
+    unsigned char* pages = mmap(NULL, 2 * pageSize, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED || mprotect(pages + pageSize, pageSize,
+                                        PROT_NONE)) {
+        perror("mmap");
+        return 1;
+    }
+    unsigned char* bytes = pages + pageSize - sizeof(longCodes);
+    memcpy(bytes, longCodes, sizeof(longCodes));
+
+    aiger* aig = aiger_init();
+    const char* error = aiger_read_from_buffer(aig, (const char*) bytes,
+                                               sizeof(longCodes));
+    int failed = 0;
+    if (error != NULL) {
+        fprintf(stderr, "longcode: %s\n", error);
+        failed = 1;
+    } else if (aig->num_ands != 1 || aig->ands[0].lhs != 2 ||
+               aig->ands[0].rhs0 != 0 || aig->ands[0].rhs1 != 0) {
+        fprintf(stderr, "longcode: wrong and gate\n");
+        failed = 1;
+    }
+    aiger_reset(aig);
+    munmap(pages, 2 * pageSize);
+    return failed;
+}
@@ -0,0 +1,179 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+/* Test for the products of aigprod: the AIGs given as arguments, e.g. the
+ * products of the same components built in different modes, must have the
+ * same inputs (by name) and number of outputs, and their outputs must agree
+ * in every step of pseudo-random runs from the reset state.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aiger/aiger.h"
+
+#define RUNS 256
+#define STEPS 64
+
+typedef struct {
+    aiger* aig;
+    // position of each of its inputs among the inputs of the first AIG
+    unsigned* inputIdx;
+    bool* sim;
+    bool* state;
+} Circuit;
+
+static unsigned xorshift(unsigned* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+static inline bool simValue(const bool* sim, unsigned lit) {
+    return sim[aiger_lit2var(lit)] != aiger_sign(lit);
+}
+
+static const char* load(Circuit* c, const char* name, const aiger* first) {
+    c->aig = aiger_init();
+    c->inputIdx = NULL;
+    c->sim = NULL;
+    c->state = NULL;
+    const char* error = aiger_open_and_read_from_file(c->aig, name);
+    if (error != NULL)
+        return error;
+    aiger* aig = c->aig;
+    // simulation needs the and gates in topological order
+    aiger_reencode(aig);
+    for (unsigned i = 0; i < aig->num_latches; i++) {
+        if (aig->latches[i].reset != aiger_false
+                && aig->latches[i].reset != aiger_true)
+            return "uninitialized latch";
+    }
+    if (first == NULL)
+        first = aig;
+    if (aig->num_inputs != first->num_inputs
+            || aig->num_outputs != first->num_outputs)
+        return "different number of inputs or outputs";
+    c->inputIdx = malloc((aig->num_inputs + 1) * sizeof(unsigned));
+    for (unsigned i = 0; i < aig->num_inputs; i++) {
+        unsigned j = 0;
+        while (j < first->num_inputs
+                && (aig->inputs[i].name == NULL
+                    || first->inputs[j].name == NULL
+                    || strcmp(aig->inputs[i].name,
+                              first->inputs[j].name) != 0))
+            j++;
+        if (j == first->num_inputs)
+            return "unnamed or unmatched input";
+        c->inputIdx[i] = j;
+    }
+    c->sim = malloc((aig->maxvar + 1) * sizeof(bool));
+    c->state = malloc((aig->num_latches + 1) * sizeof(bool));
+    return NULL;
+}
+
+static void reset(Circuit* c) {
+    for (unsigned i = 0; i < c->aig->num_latches; i++)
+        c->state[i] = c->aig->latches[i].reset == aiger_true;
+}
+
+static void step(Circuit* c, const bool* inputs) {
+    aiger* aig = c->aig;
+    c->sim[0] = false;
+    for (unsigned i = 0; i < aig->num_inputs; i++)
+        c->sim[aiger_lit2var(aig->inputs[i].lit)] = inputs[c->inputIdx[i]];
+    for (unsigned i = 0; i < aig->num_latches; i++)
+        c->sim[aiger_lit2var(aig->latches[i].lit)] = c->state[i];
+    for (unsigned i = 0; i < aig->num_ands; i++) {
+        aiger_and* gate = aig->ands + i;
+        c->sim[aiger_lit2var(gate->lhs)] = simValue(c->sim, gate->rhs0)
+                                           && simValue(c->sim, gate->rhs1);
+    }
+    for (unsigned i = 0; i < aig->num_latches; i++)
+        c->state[i] = simValue(c->sim, aig->latches[i].next);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: prodsim AIG AIG...\n");
+        return 1;
+    }
+    int noCircuits = argc - 1;
+    Circuit* circuits = malloc(noCircuits * sizeof(Circuit));
+    int failed = 0;
+    int loaded = 0;
+    while (!failed && loaded < noCircuits) {
+        const char* error = load(circuits + loaded, argv[loaded + 1],
+                                 loaded ? circuits[0].aig : NULL);
+        loaded++;
+        if (error != NULL) {
+            fprintf(stderr, "prodsim: %s: %s\n", argv[loaded], error);
+            failed = 1;
+        }
+    }
+
+    aiger* first = circuits[0].aig;
+    bool* inputs = malloc((first->num_inputs + 1) * sizeof(bool));
+    unsigned seed = 2463534242u;
+    bool someOutput = false;
+    for (int run = 0; !failed && run < RUNS; run++) {
+        for (int c = 0; c < noCircuits; c++)
+            reset(circuits + c);
+        for (int s = 0; !failed && s < STEPS; s++) {
+            for (unsigned i = 0; i < first->num_inputs; i++)
+                inputs[i] = xorshift(&seed) & 1;
+            for (int c = 0; c < noCircuits; c++)
+                step(circuits + c, inputs);
+            for (unsigned o = 0; o < first->num_outputs; o++) {
+                bool value = simValue(circuits[0].sim, first->outputs[o].lit);
+                someOutput |= value;
+                for (int c = 1; !failed && c < noCircuits; c++) {
+                    aiger* aig = circuits[c].aig;
+                    if (simValue(circuits[c].sim, aig->outputs[o].lit)
+                            != value) {
+                        fprintf(stderr, "prodsim: output %u of %s differs "
+                                        "in step %d of run %d\n",
+                                o, argv[c + 1], s, run);
+                        failed = 1;
+                    }
+                }
+            }
+        }
+    }
+    // the outputs should not all be constant false
+    if (!failed && !someOutput) {
+        fprintf(stderr, "prodsim: no output is ever true\n");
+        failed = 1;
+    }
+
+    free(inputs);
+    for (int c = 0; c < loaded; c++) {
+        free(circuits[c].state);
+        free(circuits[c].sim);
+        free(circuits[c].inputIdx);
+        aiger_reset(circuits[c].aig);
+    }
+    free(circuits);
+    return failed;
+}
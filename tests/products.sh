@@ -0,0 +1,18 @@
+#!/bin/sh
+# Test for aigprod: the products of the components of a small task system
+# built flat, as a tree, with merged latches and by appending a component
+# to a product must be equivalent (see prodsim.c). Run from the top-level
+# directory after building task2aig, aigprod and tests/prodsim.
+set -e
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+for i in 0 1 2; do
+    ./task2aig -e 1-2 3 $i 6 0 2 3 > "$dir/c$i.aag"
+done
+cd "$dir"
+"$OLDPWD/aigprod" c0.aag c1.aag c2.aag > flat.aag
+"$OLDPWD/aigprod" --tree c0.aag c1.aag c2.aag > tree.aag
+"$OLDPWD/aigprod" --merge-latches c0.aag c1.aag c2.aag > merged.aag
+"$OLDPWD/aigprod" c0.aag c1.aag > first.aag
+"$OLDPWD/aigprod" --append first.aag c2.aag > appended.aag
+"$OLDPWD/tests/prodsim" flat.aag tree.aag merged.aag appended.aag
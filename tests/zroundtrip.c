@@ -0,0 +1,166 @@
+/**************************************************************************
+ * Copyright (c) 2020- Guillermo A. Perez
+ *
+ * TASK2AIG is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * TASK2AIG is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with TASK2AIG. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Guillermo A. Perez
+ * University of Antwerp
+ * guillermoalberto.perez@uantwerpen.be
+ *************************************************************************/
+
+/* Test for writing and reading back compressed binary AIGs: a pseudo-random
+ * AIG (large enough to need several buffers of compressed data) written to
+ * '.aig.gz' and '.aig.zst' files is read back unchanged. Without zlib or
+ * zstd compiled in, the 'gzip' and 'zstd' programs are used and a format is
+ * skipped if its program is missing.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../aiger/aiger.h"
+
+#define INPUTS 100
+#define LATCHES 50
+#define ANDS 20000
+
+static unsigned xorshift(unsigned* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+static aiger* randomAig() {
+    aiger* aig = aiger_init();
+    unsigned seed = 2463534242u;
+    char name[32];
+    unsigned var = 1;
+    for (unsigned i = 0; i < INPUTS; i++, var++) {
+        sprintf(name, "i%u", i);
+        aiger_add_input(aig, 2 * var, i % 2 ? name : NULL);
+    }
+    unsigned firstLatch = var;
+    var += LATCHES;
+    for (unsigned i = 0; i < ANDS; i++, var++)
+        aiger_add_and(aig, 2 * var, xorshift(&seed) % (2 * var),
+                      xorshift(&seed) % (2 * var));
+    for (unsigned i = 0; i < LATCHES; i++) {
+        sprintf(name, "l%u", i);
+        aiger_add_latch(aig, 2 * (firstLatch + i),
+                        xorshift(&seed) % (2 * var), name);
+        aiger_add_reset(aig, 2 * (firstLatch + i), i % 2);
+    }
+    aiger_add_output(aig, 2 * (var - 1), "o");
+    aiger_add_bad(aig, 2 * (var - 2) + 1, NULL);
+    aiger_add_comment(aig, "compressed round-trip");
+    return aig;
+}
+
+static bool sameSymbols(const aiger_symbol* a, const aiger_symbol* b,
+                        unsigned size) {
+    for (unsigned i = 0; i < size; i++) {
+        if (a[i].lit != b[i].lit || a[i].next != b[i].next
+                || a[i].reset != b[i].reset
+                || (a[i].name == NULL) != (b[i].name == NULL)
+                || (a[i].name != NULL && strcmp(a[i].name, b[i].name) != 0))
+            return false;
+    }
+    return true;
+}
+
+static bool sameAig(const aiger* a, const aiger* b) {
+    if (a->maxvar != b->maxvar || a->num_inputs != b->num_inputs
+            || a->num_latches != b->num_latches
+            || a->num_outputs != b->num_outputs
+            || a->num_bad != b->num_bad || a->num_ands != b->num_ands)
+        return false;
+    if (!sameSymbols(a->inputs, b->inputs, a->num_inputs)
+            || !sameSymbols(a->latches, b->latches, a->num_latches)
+            || !sameSymbols(a->outputs, b->outputs, a->num_outputs)
+            || !sameSymbols(a->bad, b->bad, a->num_bad))
+        return false;
+    if (memcmp(a->ands, b->ands, a->num_ands * sizeof(aiger_and)) != 0)
+        return false;
+    unsigned i = 0;
+    for (; a->comments[i] != NULL && b->comments[i] != NULL; i++) {
+        if (strcmp(a->comments[i], b->comments[i]) != 0)
+            return false;
+    }
+    return a->comments[i] == NULL && b->comments[i] == NULL;
+}
+
+static bool available(const char* program) {
+    char command[64];
+    sprintf(command, "%s --version > /dev/null 2>&1", program);
+    return system(command) == 0;
+}
+
+static int roundTrip(aiger* aig, const char* dir, const char* suffix) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/random.aig.%s", dir, suffix);
+    if (!aiger_open_and_write_to_file(aig, path)) {
+        fprintf(stderr, "zroundtrip: cannot write %s\n", path);
+        return 1;
+    }
+    aiger* read = aiger_init();
+    const char* error = aiger_open_and_read_from_file(read, path);
+    int failed = 0;
+    if (error != NULL) {
+        fprintf(stderr, "zroundtrip: %s\n", error);
+        failed = 1;
+    } else if (!sameAig(aig, read)) {
+        fprintf(stderr, "zroundtrip: %s differs\n", path);
+        failed = 1;
+    }
+    aiger_reset(read);
+    unlink(path);
+    return failed;
+}
+
+int main(void) {
+    char dir[] = "/tmp/zroundtripXXXXXX";
+    if (mkdtemp(dir) == NULL) {
+        perror("mkdtemp");
+        return 1;
+    }
+    aiger* aig = randomAig();
+    const char* error = aiger_check(aig);
+    int failed = 0;
+    if (error != NULL) {
+        fprintf(stderr, "zroundtrip: %s\n", error);
+        failed = 1;
+    }
+    // writing reencodes the AIG, which is what we get back
+#ifndef AIGER_HAVE_ZLIB
+    if (!failed && !available("gzip"))
+        fprintf(stderr, "zroundtrip: no gzip, skipping '.gz'\n");
+    else
+#endif
+    if (!failed)
+        failed = roundTrip(aig, dir, "gz");
+#ifndef AIGER_HAVE_ZSTD
+    if (!failed && !available("zstd"))
+        fprintf(stderr, "zroundtrip: no zstd, skipping '.zst'\n");
+    else
+#endif
+    if (!failed)
+        failed = roundTrip(aig, dir, "zst");
+    aiger_reset(aig);
+    rmdir(dir);
+    return failed;
+}